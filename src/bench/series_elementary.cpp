@@ -0,0 +1,99 @@
+#include "power_series.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+using namespace std;
+
+// -----------------------------------------------------------------------------
+// Time power_series::exp, log, pow and sqrt (Newton iteration) against the
+// O(n^2) recurrences that follow from g' = f'g, f' = fg' and f.g' = a.f'.g.
+
+template <typename F>
+double seconds(F f)
+{
+  auto start = chrono::steady_clock::now();
+  f();
+  return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+// exp f, f[0] = 0
+vector<double> naive_exp(const vector<double>& f, size_t n)
+{
+  vector<double> g(n);
+  g[0] = 1;
+  for (size_t i = 1; i < n; ++i)
+  {
+    double s = 0;
+    for (size_t k = 1; k <= i && k < f.size(); ++k)
+      s += static_cast<double>(k) * f[k] * g[i - k];
+    g[i] = s / static_cast<double>(i);
+  }
+  return g;
+}
+
+// log f, f[0] = 1
+vector<double> naive_log(const vector<double>& f, size_t n)
+{
+  vector<double> g(n);
+  for (size_t i = 1; i < n; ++i)
+  {
+    double s = 0;
+    for (size_t k = 1; k < i && i - k < f.size(); ++k)
+      s += static_cast<double>(k) * g[k] * f[i - k];
+    g[i] = (i < f.size() ? f[i] : 0) - s / static_cast<double>(i);
+  }
+  return g;
+}
+
+// f^a, f[0] = 1
+vector<double> naive_pow(const vector<double>& f, double a, size_t n)
+{
+  vector<double> g(n);
+  g[0] = 1;
+  for (size_t i = 1; i < n; ++i)
+  {
+    double s = 0;
+    for (size_t k = 1; k <= i && k < f.size(); ++k)
+      s += (a * static_cast<double>(k) - static_cast<double>(i - k)) * f[k] * g[i - k];
+    g[i] = s / static_cast<double>(i);
+  }
+  return g;
+}
+
+template <typename Naive, typename Newton>
+void run(const char* name, Naive naive, Newton newton)
+{
+  printf("%s\n%10s %12s %12s\n", name, "n", "naive", "newton");
+  for (size_t n = 16; n <= (size_t{1} << 18); n *= 4)
+  {
+    vector<double> f(n);
+    for (size_t i = 1; i < n; ++i)
+      f[i] = 1.0 / static_cast<double>(i * i);
+    double t_naive = n <= (size_t{1} << 16) ?
+      seconds([&] { naive(f, n); }) : 0;
+    double t_newton = seconds([&] { newton(f, n); });
+    printf("%10zu %12.6f %12.6f\n", n, t_naive, t_newton);
+  }
+}
+
+int main()
+{
+  run("exp",
+      [] (const vector<double>& f, size_t n) { return naive_exp(f, n); },
+      [] (const vector<double>& f, size_t n) { return power_series::exp(f, n); });
+
+  // the remaining operations want f[0] = 1
+  auto one_plus = [] (vector<double> f) { f[0] = 1; return f; };
+  run("log",
+      [&] (const vector<double>& f, size_t n) { return naive_log(one_plus(f), n); },
+      [&] (const vector<double>& f, size_t n) { return power_series::log(one_plus(f), n); });
+  run("pow 1/3",
+      [&] (const vector<double>& f, size_t n) { return naive_pow(one_plus(f), 1.0/3, n); },
+      [&] (const vector<double>& f, size_t n) { return power_series::pow(one_plus(f), 1.0/3, n); });
+  run("sqrt",
+      [&] (const vector<double>& f, size_t n) { return naive_pow(one_plus(f), 0.5, n); },
+      [&] (const vector<double>& f, size_t n) { return power_series::sqrt(one_plus(f), n); });
+  return 0;
+}
@@ -0,0 +1,57 @@
+#include "power_series.hpp"
+#include "modular.hpp"
+
+#include <range/v3/all.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+using namespace std;
+using namespace ranges;
+
+// -----------------------------------------------------------------------------
+// Time power_series::multiply under each strategy as the operands grow, to
+// find where the cutoffs in karatsuba.hpp and fft.hpp should sit.
+
+template <typename F>
+double seconds(F f)
+{
+  auto start = chrono::steady_clock::now();
+  f();
+  return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+template <typename T, typename Strategy>
+double time_multiply(const vector<T>& v1, const vector<T>& v2, Strategy s)
+{
+  return seconds([&] {
+      auto m = power_series::multiply(v1, v2, s);
+      volatile T sink = ranges::accumulate(m, T{});
+      (void)sink;
+    });
+}
+
+template <typename T>
+void run(const char* name, size_t max_naive)
+{
+  printf("%s\n%10s %12s %12s %12s\n", name, "n", "naive", "karatsuba", "fft");
+  for (size_t n = 16; n <= (size_t{1} << 18); n *= 2)
+  {
+    vector<T> v1(n, T{1});
+    vector<T> v2(n, T{2});
+    double naive = n <= max_naive ?
+      time_multiply(v1, v2, series_mult_strategy::naive{}) : 0;
+    double karatsuba = time_multiply(v1, v2, series_mult_strategy::karatsuba{});
+    double fft = time_multiply(v1, v2, series_mult_strategy::fft{});
+    printf("%10zu %12.6f %12.6f %12.6f\n", n, naive, karatsuba, fft);
+  }
+}
+
+int main()
+{
+  run<int>("int", 1u << 14);
+  run<double>("double", 1u << 14);
+  run<power_series::modular<998244353>>("modular<998244353>", 1u << 14);
+  return 0;
+}
@@ -0,0 +1,60 @@
+#include "power_series.hpp"
+
+#include <range/v3/all.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace ranges;
+
+// -----------------------------------------------------------------------------
+// Time power_series::multiply_parallel on 1, 2, 4, ... threads up to the
+// hardware concurrency, against the single-threaded strategies.
+
+template <typename F>
+double seconds(F f)
+{
+  auto start = chrono::steady_clock::now();
+  f();
+  return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+template <typename T>
+void run(const char* name, size_t n)
+{
+  vector<T> v1(n, T{1});
+  vector<T> v2(n, T{2});
+  printf("%s, n = %zu\n", name, n);
+  double naive = seconds([&] {
+      auto m = power_series::multiply(v1, v2, series_mult_strategy::naive{});
+      volatile T sink = ranges::accumulate(m, T{});
+      (void)sink;
+    });
+  double automatic = seconds([&] {
+      auto m = power_series::multiply(v1, v2);
+      volatile T sink = ranges::accumulate(m, T{});
+      (void)sink;
+    });
+  printf("%10s %12.6f\n%10s %12.6f\n%10s %12s %12s\n",
+         "naive", naive, "automatic", automatic, "threads", "parallel", "speedup");
+  size_t max_threads = max(1u, thread::hardware_concurrency());
+  double base = 0;
+  for (size_t threads = 1; threads <= max_threads; threads *= 2)
+  {
+    thread_pool pool{threads};
+    double t = seconds([&] { power_series::multiply_parallel(v1, v2, pool); });
+    if (threads == 1)
+      base = t;
+    printf("%10zu %12.6f %12.2f\n", threads, t, base / t);
+  }
+}
+
+int main()
+{
+  run<int>("int", 1u << 15);
+  run<double>("double", 1u << 15);
+  return 0;
+}
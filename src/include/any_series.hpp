@@ -0,0 +1,178 @@
+#pragma once
+
+#include <range/v3/core.hpp>
+#include <range/v3/view/all.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace ranges
+{
+  inline namespace v3
+  {
+    namespace detail
+    {
+      // A position in some series, read a block at a time.
+      template <typename T>
+      struct any_series_reader
+      {
+        virtual ~any_series_reader() = default;
+        // writes the next coefficients to out[0, n) and returns how many
+        // there were, fewer than n only at the end of the series
+        virtual std::size_t fill(T *out, std::size_t n) = 0;
+        virtual std::unique_ptr<any_series_reader> clone() const = 0;
+      };
+
+      template <typename T>
+      struct any_series_source
+      {
+        virtual ~any_series_source() = default;
+        // a reader at the start of the series
+        virtual std::unique_ptr<any_series_reader<T>> read() = 0;
+      };
+
+      // The series itself is shared by every reader of it; each reader
+      // keeps only an iterator.
+      template <typename T, typename Rng>
+      struct any_series_model
+        : any_series_source<T>
+      {
+      private:
+        Rng rng_;
+
+        struct reader
+          : any_series_reader<T>
+        {
+          range_iterator_t<Rng> it_;
+          range_sentinel_t<Rng> end_;
+
+          reader(range_iterator_t<Rng> it, range_sentinel_t<Rng> end)
+            : it_(std::move(it))
+            , end_(std::move(end))
+          {}
+          std::size_t fill(T *out, std::size_t n) override
+          {
+            std::size_t i = 0;
+            for (; i < n && it_ != end_; ++i, ++it_)
+              out[i] = *it_;
+            return i;
+          }
+          std::unique_ptr<any_series_reader<T>> clone() const override
+          {
+            return std::unique_ptr<any_series_reader<T>>{new reader{*this}};
+          }
+        };
+
+      public:
+        explicit any_series_model(Rng rng)
+          : rng_(std::move(rng))
+        {}
+        std::unique_ptr<any_series_reader<T>> read() override
+        {
+          return std::unique_ptr<any_series_reader<T>>{
+            new reader{begin(rng_), end(rng_)}};
+        }
+      };
+    } // namespace detail
+
+    // A series of T of any type: expressions of any depth go in, and
+    // any_series<T> comes out, which can be stored, passed between
+    // translation units and composed again at run time. Cursors fill a
+    // block of coefficients per virtual call, so the indirection costs
+    // one call every block rather than one per coefficient. Copies share
+    // the series; each cursor reads it independently.
+    template <typename T>
+    struct any_series
+      : view_facade<any_series<T>, unknown>
+    {
+    private:
+      friend range_access;
+      static constexpr std::size_t block_size = 64;
+      std::shared_ptr<detail::any_series_source<T>> source_;
+
+      struct cursor
+      {
+      private:
+        std::unique_ptr<detail::any_series_reader<T>> reader_;
+        // copies of a cursor share the block until one of them refills it
+        std::shared_ptr<std::vector<T>> block_;
+        std::size_t size_ = 0;
+        std::size_t pos_ = 0;
+        std::size_t n_ = 0;
+
+        void refill()
+        {
+          if (!block_ || block_.use_count() > 1)
+            block_ = std::make_shared<std::vector<T>>(std::size_t{block_size});
+          size_ = reader_ ? reader_->fill(block_->data(), block_size) : 0;
+          pos_ = 0;
+        }
+      public:
+        cursor() = default;
+        explicit cursor(detail::any_series_source<T> *source)
+          : reader_{source ? source->read() : nullptr}
+        {
+          refill();
+        }
+        cursor(cursor const &that)
+          : reader_{that.reader_ ? that.reader_->clone() : nullptr}
+          , block_{that.block_}
+          , size_{that.size_}
+          , pos_{that.pos_}
+          , n_{that.n_}
+        {}
+        cursor(cursor &&) = default;
+        cursor &operator=(cursor const &that)
+        {
+          if (this != &that)
+            *this = cursor{that};
+          return *this;
+        }
+        cursor &operator=(cursor &&) = default;
+
+        T current() const
+        {
+          return (*block_)[pos_];
+        }
+        bool done() const
+        {
+          return pos_ == size_;
+        }
+        void next()
+        {
+          ++n_;
+          if (++pos_ == size_ && size_ == block_size)
+            refill();
+        }
+        bool equal(cursor const &that) const
+        {
+          return n_ == that.n_;
+        }
+      };
+
+      cursor begin_cursor() const
+      {
+        return cursor{source_.get()};
+      }
+
+    public:
+      any_series() = default;
+      template <typename Rng,
+                CONCEPT_REQUIRES_(ForwardRange<Rng>() &&
+                                  !Same<uncvref_t<Rng>, any_series>())>
+      any_series(Rng &&r)
+        : source_{std::make_shared<detail::any_series_model<T, all_t<Rng>>>(
+              all(std::forward<Rng>(r)))}
+      {}
+      // a single virtual call for the lot
+      std::size_t fill(T *out, std::size_t n) const
+      {
+        if (!source_)
+          return 0;
+        return source_->read()->fill(out, n);
+      }
+    };
+  }  // inline namespace v3
+} // namespace ranges
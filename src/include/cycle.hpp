@@ -1,7 +1,12 @@
 #pragma once
 
+#include "series_fill.hpp"
+
 #include <range/v3/core.hpp>
 
+#include <algorithm>
+#include <cstddef>
+
 namespace ranges
 {
   inline namespace v3
@@ -75,6 +80,22 @@ namespace ranges
       explicit cycle_view(Rng r)
         : r_(std::move(r))
       {}
+      Rng const &base() const
+      {
+        return r_;
+      }
+      // one period is read, and copied on in doubling runs
+      template<typename T,
+               CONCEPT_REQUIRES_(Range<Rng const>())>
+      std::size_t fill(T *out, std::size_t n) const
+      {
+        std::size_t period = series_fill(r_, out, n);
+        if (period == 0)
+          return 0;
+        for (std::size_t i = period; i < n; i *= 2)
+          std::copy(out, out + std::min(i, n - i), out + i);
+        return n;
+      }
     };
 
     namespace view
@@ -0,0 +1,307 @@
+#pragma once
+
+#include "modular.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace ranges
+{
+  inline namespace v3
+  {
+    namespace detail
+    {
+      // primes of the form c.2^k + 1 with primitive root 3
+      constexpr std::uint32_t ntt_prime1 = 998244353; // 119.2^23 + 1
+      constexpr std::uint32_t ntt_prime2 = 167772161; // 5.2^25 + 1
+      constexpr std::uint32_t ntt_prime3 = 469762049; // 7.2^26 + 1
+      constexpr std::size_t ntt_max_size = std::size_t{1} << 23;
+
+      template <std::uint32_t M>
+      using is_ntt_prime = std::integral_constant<bool,
+        M == ntt_prime1 || M == ntt_prime2 || M == ntt_prime3>;
+
+      // coefficient types the transforms know how to multiply exactly
+      // (integers, modular) or to within rounding (floating point)
+      template <typename T>
+      struct is_fft_coefficient
+        : std::integral_constant<bool, std::is_arithmetic<T>::value &&
+                                       !std::is_same<T, bool>::value>
+      {};
+      template <std::uint32_t M>
+      struct is_fft_coefficient<power_series::modular<M>>
+        : std::true_type
+      {};
+
+      // The three-prime CRT recovers an integer coefficient only while
+      // |c| < p1.p2.p3 / 2, about 2^85. A product of 32-bit integers of at
+      // most ntt_max_size terms stays inside that; 64-bit products don't,
+      // and would come back wrong rather than wrapped, so wider integers
+      // are multiplied by Karatsuba whatever the strategy says.
+      template <typename T>
+      struct fft_applies
+        : std::integral_constant<bool, is_fft_coefficient<T>::value &&
+                                       (!std::is_integral<T>::value ||
+                                        sizeof(T) <= sizeof(std::int32_t))>
+      {};
+
+      // Below this many coefficients (of the shorter operand) Karatsuba is
+      // faster than transforming. Integers need three NTTs and a CRT, so
+      // they cross over much later than doubles or a single NTT prime.
+      // See src/bench/series_mult.cpp.
+      template <typename T>
+      struct fft_cutoff
+        : std::integral_constant<std::size_t,
+                                 std::is_floating_point<T>::value ? 1024 : 32768>
+      {};
+      template <std::uint32_t M>
+      struct fft_cutoff<power_series::modular<M>>
+        : std::integral_constant<std::size_t, 128>
+      {};
+
+      inline std::size_t fft_size(std::size_t n)
+      {
+        std::size_t s = 1;
+        while (s < n) s <<= 1;
+        return s;
+      }
+
+      template <typename T>
+      void bit_reverse(std::vector<T> &a)
+      {
+        std::size_t n = a.size();
+        for (std::size_t i = 1, j = 0; i < n; ++i)
+        {
+          std::size_t bit = n >> 1;
+          for (; j & bit; bit >>= 1)
+            j ^= bit;
+          j ^= bit;
+          if (i < j)
+            std::swap(a[i], a[j]);
+        }
+      }
+
+      // iterative radix-2 transform; a.size() must be a power of two
+      inline void fft(std::vector<std::complex<double>> &a, bool inverse)
+      {
+        using complex = std::complex<double>;
+        std::size_t n = a.size();
+        bit_reverse(a);
+        std::vector<complex> w;
+        for (std::size_t len = 2; len <= n; len <<= 1)
+        {
+          std::size_t half = len / 2;
+          double angle = (inverse ? 2 : -2) * std::acos(-1.0) / static_cast<double>(len);
+          w.resize(half);
+          for (std::size_t k = 0; k < half; ++k)
+            w[k] = std::polar(1.0, angle * static_cast<double>(k));
+          for (std::size_t i = 0; i < n; i += len)
+            for (std::size_t k = 0; k < half; ++k)
+            {
+              complex u = a[i + k];
+              complex v = a[i + k + half] * w[k];
+              a[i + k] = u + v;
+              a[i + k + half] = u - v;
+            }
+        }
+        if (inverse)
+          for (auto &x : a)
+            x /= static_cast<double>(n);
+      }
+
+      // number-theoretic transform over one of the ntt primes
+      template <std::uint32_t P>
+      void ntt(std::vector<power_series::modular<P>> &a, bool inverse)
+      {
+        using mod = power_series::modular<P>;
+        std::size_t n = a.size();
+        bit_reverse(a);
+        std::vector<mod> w;
+        for (std::size_t len = 2; len <= n; len <<= 1)
+        {
+          std::size_t half = len / 2;
+          mod wlen = mod{3}.pow((P - 1) / len);
+          if (inverse)
+            wlen = wlen.inverse();
+          w.resize(half);
+          w[0] = 1;
+          for (std::size_t k = 1; k < half; ++k)
+            w[k] = w[k - 1] * wlen;
+          for (std::size_t i = 0; i < n; i += len)
+            for (std::size_t k = 0; k < half; ++k)
+            {
+              mod u = a[i + k];
+              mod v = a[i + k + half] * w[k];
+              a[i + k] = u + v;
+              a[i + k + half] = u - v;
+            }
+        }
+        if (inverse)
+        {
+          mod n_inv = mod{static_cast<std::int64_t>(n)}.inverse();
+          for (auto &x : a)
+            x *= n_inv;
+        }
+      }
+
+      // Length of cyclic convolution that gives coefficients [lo, hi) of a
+      // product of lengths na and nb: coefficient i + L, which wraps onto
+      // i, must be past the end of the product. For the whole product
+      // that's the usual na + nb - 1; for the upper half of a 2k by k
+      // product (as Newton iteration wants) it is 2k rather than 4k.
+      inline std::size_t fft_middle_size(std::size_t na, std::size_t nb,
+                                         std::size_t lo, std::size_t hi)
+      {
+        return fft_size(std::max(hi, na + nb - 1 - lo));
+      }
+
+      // cyclic convolution of length n over prime P
+      template <std::uint32_t P, typename F>
+      std::vector<power_series::modular<P>> ntt_convolve(
+          std::size_t na, std::size_t nb, std::size_t n, F residue)
+      {
+        using mod = power_series::modular<P>;
+        std::vector<mod> fa(n), fb(n);
+        for (std::size_t i = 0; i < na; ++i)
+          fa[i] = residue(0, i);
+        for (std::size_t i = 0; i < nb; ++i)
+          fb[i] = residue(1, i);
+        ntt(fa, false);
+        ntt(fb, false);
+        for (std::size_t i = 0; i < n; ++i)
+          fa[i] *= fb[i];
+        ntt(fa, true);
+        return fa;
+      }
+
+      // Mixed-radix digits of a coefficient known modulo all three primes:
+      // x = d0 + d1.p1 + d2.p1.p2, exact as long as |x| < p1.p2.p3 / 2.
+      struct crt_digits
+      {
+        std::uint32_t d0, d1, d2;
+
+        crt_digits(std::uint32_t r1, std::uint32_t r2, std::uint32_t r3)
+        {
+          using m2 = power_series::modular<ntt_prime2>;
+          using m3 = power_series::modular<ntt_prime3>;
+          m2 k1 = (m2{r2} - m2{r1}) / m2{ntt_prime1};
+          m3 k2 = ((m3{r3} - m3{r1}) / m3{ntt_prime1} - m3{k1.value()})
+            / m3{ntt_prime2};
+          d0 = r1;
+          d1 = k1.value();
+          d2 = k2.value();
+        }
+
+        // x modulo 2^64, reading the digits as the representative of
+        // least absolute value; that is x itself while |x| < p1.p2.p3 / 2
+        std::uint64_t wrap() const
+        {
+          constexpr std::uint64_t p12 =
+            static_cast<std::uint64_t>(ntt_prime1) * ntt_prime2;
+          std::uint64_t x = d0 + static_cast<std::uint64_t>(d1) * ntt_prime1
+            + p12 * d2;
+          if (d2 > ntt_prime3 / 2)
+            x -= p12 * ntt_prime3;
+          return x;
+        }
+
+        // x modulo M, reading x as non-negative
+        template <std::uint32_t M>
+        power_series::modular<M> reduce() const
+        {
+          using mod = power_series::modular<M>;
+          constexpr std::uint64_t p12 =
+            static_cast<std::uint64_t>(ntt_prime1) * ntt_prime2;
+          std::uint64_t low = d0 + static_cast<std::uint64_t>(d1) * ntt_prime1;
+          return mod{static_cast<std::int64_t>(low % M)}
+            + mod{static_cast<std::int64_t>(p12 % M)} * mod{d2};
+        }
+      };
+
+      // out[0, hi-lo) = coefficients [lo, hi) of a * b for floating point
+      // coefficients
+      template <typename T,
+                typename std::enable_if<std::is_floating_point<T>::value, int>::type = 0>
+      void fft_mult(T const *a, std::size_t na, T const *b, std::size_t nb,
+                    T *out, std::size_t lo, std::size_t hi)
+      {
+        // pack a into the real and b into the imaginary part: the imaginary
+        // part of the square is then 2ab
+        std::vector<std::complex<double>> f(fft_middle_size(na, nb, lo, hi));
+        for (std::size_t i = 0; i < na; ++i)
+          f[i].real(static_cast<double>(a[i]));
+        for (std::size_t i = 0; i < nb; ++i)
+          f[i].imag(static_cast<double>(b[i]));
+        fft(f, false);
+        for (auto &x : f)
+          x *= x;
+        fft(f, true);
+        for (std::size_t i = lo; i < hi; ++i)
+          out[i - lo] = static_cast<T>(f[i].imag() / 2);
+      }
+
+      // out[0, hi-lo) = coefficients [lo, hi) of a * b for integer
+      // coefficients of at most 32 bits, wrapped to T as the other kernels
+      // wrap. Unsigned coefficients are read as their signed counterparts,
+      // which gives the same product modulo 2^32 and keeps every
+      // coefficient of it within the CRT's range (see fft_applies).
+      template <typename T,
+                typename std::enable_if<std::is_integral<T>::value &&
+                                        fft_applies<T>::value, int>::type = 0>
+      void fft_mult(T const *a, std::size_t na, T const *b, std::size_t nb,
+                    T *out, std::size_t lo, std::size_t hi)
+      {
+        using S = typename std::make_signed<T>::type;
+        auto residue = [&] (int which, std::size_t i) {
+          return static_cast<std::int64_t>(static_cast<S>(which == 0 ? a[i] : b[i]));
+        };
+        std::size_t n = fft_middle_size(na, nb, lo, hi);
+        auto c1 = ntt_convolve<ntt_prime1>(na, nb, n, residue);
+        auto c2 = ntt_convolve<ntt_prime2>(na, nb, n, residue);
+        auto c3 = ntt_convolve<ntt_prime3>(na, nb, n, residue);
+        for (std::size_t i = lo; i < hi; ++i)
+          out[i - lo] = static_cast<T>(
+              crt_digits{c1[i].value(), c2[i].value(), c3[i].value()}.wrap());
+      }
+
+      // out[0, hi-lo) = coefficients [lo, hi) of a * b for modular
+      // coefficients
+      template <std::uint32_t M>
+      void fft_mult(power_series::modular<M> const *a, std::size_t na,
+                    power_series::modular<M> const *b, std::size_t nb,
+                    power_series::modular<M> *out, std::size_t lo, std::size_t hi)
+      {
+        auto residue = [&] (int which, std::size_t i) {
+          return static_cast<std::int64_t>(which == 0 ? a[i].value() : b[i].value());
+        };
+        std::size_t n = fft_middle_size(na, nb, lo, hi);
+        if (is_ntt_prime<M>::value)
+        {
+          auto c = ntt_convolve<M>(na, nb, n, residue);
+          std::copy(c.begin() + static_cast<std::ptrdiff_t>(lo),
+                    c.begin() + static_cast<std::ptrdiff_t>(hi), out);
+          return;
+        }
+        auto c1 = ntt_convolve<ntt_prime1>(na, nb, n, residue);
+        auto c2 = ntt_convolve<ntt_prime2>(na, nb, n, residue);
+        auto c3 = ntt_convolve<ntt_prime3>(na, nb, n, residue);
+        for (std::size_t i = lo; i < hi; ++i)
+          out[i - lo] = crt_digits{c1[i].value(), c2[i].value(), c3[i].value()}
+            .template reduce<M>();
+      }
+
+      // out[0, na+nb-1) = a * b
+      template <typename T>
+      void fft_mult(T const *a, std::size_t na, T const *b, std::size_t nb,
+                    T *out)
+      {
+        fft_mult(a, na, b, nb, out, 0, na + nb - 1);
+      }
+    } // namespace detail
+  }  // inline namespace v3
+} // namespace ranges
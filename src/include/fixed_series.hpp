@@ -0,0 +1,182 @@
+#pragma once
+
+#include <cstddef>
+#include <initializer_list>
+#include <type_traits>
+
+namespace power_series
+{
+  // N coefficients held by value, for series known at compile time such as
+  // Taylor polynomials. Everything here is constexpr, so tables built with
+  // add, subtract, negate, multiply, differentiate, integrate and compose
+  // (which take fixed_series through power_series.hpp as they take other
+  // series) are computed by the compiler, and evaluating one at a constant
+  // folds away. It's also a contiguous sized range, usable anywhere a
+  // vector is.
+  template <typename T, std::size_t N>
+  struct fixed_series
+  {
+  private:
+    T c_[N > 0 ? N : 1];
+
+  public:
+    using value_type = T;
+
+    constexpr fixed_series()
+      : c_{}
+    {}
+    // the leading coefficients; the rest are zero
+    constexpr fixed_series(std::initializer_list<T> init)
+      : c_{}
+    {
+      std::size_t i = 0;
+      for (auto const& x : init)
+        if (i < N)
+          c_[i++] = x;
+    }
+
+    static constexpr std::size_t size()
+    {
+      return N;
+    }
+    constexpr T& operator[](std::size_t i)
+    {
+      return c_[i];
+    }
+    constexpr T const& operator[](std::size_t i) const
+    {
+      return c_[i];
+    }
+    constexpr T* begin()
+    {
+      return c_;
+    }
+    constexpr T const* begin() const
+    {
+      return c_;
+    }
+    constexpr T* end()
+    {
+      return c_ + N;
+    }
+    constexpr T const* end() const
+    {
+      return c_ + N;
+    }
+
+    // the value at x, by Horner's rule
+    template <typename X>
+    constexpr auto operator()(X x) const
+    {
+      std::common_type_t<T, X> y{};
+      for (std::size_t i = N; i > 0; --i)
+        y = y * x + c_[i - 1];
+      return y;
+    }
+  };
+
+  namespace detail
+  {
+    template <typename Rng>
+    struct is_fixed_series
+      : std::false_type
+    {};
+    template <typename T, std::size_t N>
+    struct is_fixed_series<fixed_series<T, N>>
+      : std::true_type
+    {};
+
+    template <typename R1, typename R2>
+    using are_fixed_series =
+      std::integral_constant<bool,
+        is_fixed_series<std::decay_t<R1>>::value &&
+        is_fixed_series<std::decay_t<R2>>::value>;
+
+    constexpr std::size_t max_size(std::size_t a, std::size_t b)
+    {
+      return a > b ? a : b;
+    }
+
+    template <typename T, std::size_t N, std::size_t M, typename Op>
+    constexpr fixed_series<T, max_size(N, M)> fixed_add(
+        fixed_series<T, N> const& a, fixed_series<T, M> const& b, Op op)
+    {
+      fixed_series<T, max_size(N, M)> r;
+      for (std::size_t i = 0; i < max_size(N, M); ++i)
+        r[i] = op(i < N ? a[i] : T{}, i < M ? b[i] : T{});
+      return r;
+    }
+
+    template <typename T, std::size_t N>
+    constexpr fixed_series<T, N> fixed_negate(fixed_series<T, N> const& a)
+    {
+      fixed_series<T, N> r;
+      for (std::size_t i = 0; i < N; ++i)
+        r[i] = -a[i];
+      return r;
+    }
+
+    // the full product, N + M - 1 coefficients
+    template <typename T, std::size_t N, std::size_t M>
+    constexpr fixed_series<T, (N > 0 && M > 0 ? N + M - 1 : 0)> fixed_multiply(
+        fixed_series<T, N> const& a, fixed_series<T, M> const& b)
+    {
+      fixed_series<T, (N > 0 && M > 0 ? N + M - 1 : 0)> r;
+      for (std::size_t i = 0; i < N; ++i)
+        for (std::size_t j = 0; j < M; ++j)
+          r[i + j] = r[i + j] + a[i] * b[j];
+      return r;
+    }
+
+    template <typename T, std::size_t N>
+    constexpr fixed_series<T, (N > 0 ? N - 1 : 0)> fixed_derivative(
+        fixed_series<T, N> const& a)
+    {
+      fixed_series<T, (N > 0 ? N - 1 : 0)> r;
+      for (std::size_t i = 1; i < N; ++i)
+        r[i - 1] = a[i] * static_cast<T>(i);
+      return r;
+    }
+
+    // integer coefficients give float ones, as integrate does
+    template <typename T, std::size_t N>
+    constexpr fixed_series<std::common_type_t<T, float>, N + 1> fixed_integral(
+        fixed_series<T, N> const& a)
+    {
+      using U = std::common_type_t<T, float>;
+      fixed_series<U, N + 1> r;
+      for (std::size_t i = 0; i < N; ++i)
+        r[i + 1] = static_cast<U>(a[i]) / static_cast<U>(i + 1);
+      return r;
+    }
+  }
+
+  // The first K coefficients of a, padded with zeros if it's shorter.
+  template <std::size_t K, typename T, std::size_t N>
+  constexpr fixed_series<T, K> truncate(fixed_series<T, N> const& a)
+  {
+    fixed_series<T, K> r;
+    for (std::size_t i = 0; i < K && i < N; ++i)
+      r[i] = a[i];
+    return r;
+  }
+
+  // The first N coefficients of f(g), by Horner's rule in g with every
+  // product cut to N terms. g[0] must be 0.
+  template <typename T, std::size_t N, std::size_t M>
+  constexpr fixed_series<T, N> compose(fixed_series<T, N> const& f,
+                                       fixed_series<T, M> const& g)
+  {
+    fixed_series<T, N> r;
+    for (std::size_t k = N; k > 0; --k)
+    {
+      fixed_series<T, N> p;
+      for (std::size_t i = 0; i < N; ++i)
+        for (std::size_t j = 0; j < M && i + j < N; ++j)
+          p[i + j] = p[i + j] + r[i] * g[j];
+      p[0] = p[0] + f[k - 1];
+      r = p;
+    }
+    return r;
+  }
+}
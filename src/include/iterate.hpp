@@ -2,10 +2,124 @@
 
 #include <range/v3/view/generate.hpp>
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
 namespace ranges
 {
   inline namespace v3
   {
+    // x -> a.x + b, for view::iterate. Linear congruential generators are
+    // affine maps over unsigned (wrapping) or modular integers.
+    template<typename T>
+    struct affine_map
+    {
+    private:
+      T a_;
+      T b_;
+    public:
+      affine_map() = default;
+      affine_map(T a, T b)
+        : a_(std::move(a)), b_(std::move(b))
+      {}
+      T operator()(T const &x) const
+      {
+        return a_ * x + b_;
+      }
+      // this map after that one
+      affine_map after(affine_map const &that) const
+      {
+        return {a_ * that.a_, a_ * that.b_ + b_};
+      }
+      // this map applied n times, by repeated squaring
+      affine_map pow(std::uint64_t n) const
+      {
+        affine_map r{T{1}, T{0}};
+        affine_map p = *this;
+        for (; n > 0; n >>= 1)
+        {
+          if (n & 1)
+            r = p.after(r);
+          p = p.after(p);
+        }
+        return r;
+      }
+    };
+
+    // x -> M.x on vectors of N values, for view::iterate. A linear
+    // recurrence of order N steps its last N terms by its companion matrix.
+    template<typename T, std::size_t N>
+    struct matrix_map
+    {
+      using vector_type = std::array<T, N>;
+      using matrix_type = std::array<std::array<T, N>, N>;
+    private:
+      matrix_type m_;
+    public:
+      matrix_map() = default;
+      explicit matrix_map(matrix_type m)
+        : m_(std::move(m))
+      {}
+      vector_type operator()(vector_type const &x) const
+      {
+        vector_type y;
+        for (std::size_t i = 0; i < N; ++i)
+        {
+          y[i] = T{0};
+          for (std::size_t j = 0; j < N; ++j)
+            y[i] = y[i] + m_[i][j] * x[j];
+        }
+        return y;
+      }
+      // this map after that one
+      matrix_map after(matrix_map const &that) const
+      {
+        matrix_type m;
+        for (std::size_t i = 0; i < N; ++i)
+          for (std::size_t j = 0; j < N; ++j)
+          {
+            m[i][j] = T{0};
+            for (std::size_t k = 0; k < N; ++k)
+              m[i][j] = m[i][j] + m_[i][k] * that.m_[k][j];
+          }
+        return matrix_map{m};
+      }
+      // this map applied n times, by repeated squaring
+      matrix_map pow(std::uint64_t n) const
+      {
+        matrix_type identity;
+        for (std::size_t i = 0; i < N; ++i)
+          for (std::size_t j = 0; j < N; ++j)
+            identity[i][j] = T(i == j ? 1 : 0);
+        matrix_map r{identity};
+        matrix_map p = *this;
+        for (; n > 0; n >>= 1)
+        {
+          if (n & 1)
+            r = p.after(r);
+          p = p.after(p);
+        }
+        return r;
+      }
+    };
+
+    namespace detail
+    {
+      // generators that can be applied n times at once, as g.pow(n)
+      template<typename G, typename = void>
+      struct is_jumpable
+        : std::false_type
+      {};
+      template<typename G>
+      struct is_jumpable<G, typename std::enable_if<std::is_same<
+        decltype(std::declval<G const &>().pow(std::uint64_t{})), G>::value>::type>
+        : std::true_type
+      {};
+    } // namespace detail
+
     template<typename G, typename T>
     struct iterate_view
       : view_facade<iterate_view<G, T>, infinite>
@@ -38,11 +152,67 @@ namespace ranges
           view_->next();
         }
       };
+      // Over a jumpable generator each cursor keeps its own value, so the
+      // view is multi-pass, and moves n places with one call to gen_.pow.
+      struct jump_cursor
+      {
+        using difference_type = std::ptrdiff_t;
+      private:
+        iterate_view const *view_;
+        result_t val_;
+        difference_type n_;
+      public:
+        jump_cursor() = default;
+        jump_cursor(iterate_view const &view)
+          : view_(&view), val_(view.val_), n_(0)
+        {}
+        constexpr bool done() const
+        {
+          return false;
+        }
+        result_t current() const
+        {
+          return val_;
+        }
+        void next()
+        {
+          val_ = view_->gen_(val_);
+          ++n_;
+        }
+        void prev()
+        {
+          advance(-1);
+        }
+        // backwards is forwards again from the start
+        void advance(difference_type n)
+        {
+          if (n >= 0)
+            val_ = view_->gen_.pow(static_cast<std::uint64_t>(n))(val_);
+          else
+            val_ = view_->gen_.pow(static_cast<std::uint64_t>(n_ + n))(view_->val_);
+          n_ += n;
+        }
+        bool equal(jump_cursor const &that) const
+        {
+          return n_ == that.n_;
+        }
+        difference_type distance_to(jump_cursor const &that) const
+        {
+          return that.n_ - n_;
+        }
+      };
+      using jumpable_t = detail::is_jumpable<G>;
+
       void next()
       {
         val_ = gen_(val_);
       }
-      cursor begin_cursor()
+      meta::if_<jumpable_t, jump_cursor, cursor> begin_cursor()
+      {
+        return {*this};
+      }
+      CONCEPT_REQUIRES(jumpable_t::value)
+      jump_cursor begin_cursor() const
       {
         return {*this};
       }
@@ -55,6 +225,21 @@ namespace ranges
       {
         return val_;
       }
+      // the next n values from the current one, without moving on
+      template<typename U>
+      std::size_t fill(U *out, std::size_t n)
+      {
+        if (n == 0)
+          return 0;
+        result_t val = val_;
+        out[0] = val;
+        for (std::size_t i = 1; i < n; ++i)
+        {
+          val = gen_(val);
+          out[i] = val;
+        }
+        return n;
+      }
     };
 
     namespace view
@@ -0,0 +1,212 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "simd.hpp"
+
+namespace ranges
+{
+  inline namespace v3
+  {
+    namespace detail
+    {
+      // Below this many coefficients (of the shorter operand) the schoolbook
+      // product beats Karatsuba's extra additions and bookkeeping. Measured on
+      // int and double coefficients; anywhere in 24-48 is within noise.
+      constexpr std::size_t karatsuba_cutoff = 32;
+
+      // out[0, hi-lo) += coefficients [lo, hi) of a[0, na) * b[0, nb). Each
+      // coefficient is one reversed dot product, so the base case of every
+      // product below runs on the vector kernels.
+      template <typename T>
+      void schoolbook_mult_range_add(T const *a, std::size_t na,
+                                     T const *b, std::size_t nb,
+                                     T *out, std::size_t lo, std::size_t hi)
+      {
+        if (na == 0 || nb == 0)
+          return;
+        hi = std::min(hi, na + nb - 1);
+        for (std::size_t k = lo; k < hi; ++k)
+        {
+          // a[i].b[k-i] for i in [first, last]
+          std::size_t first = k < nb ? 0 : k - nb + 1;
+          std::size_t last = std::min(k, na - 1);
+          out[k - lo] += reversed_dot(a + first, b + (k - last), last - first + 1);
+        }
+      }
+
+      // out[0, na+nb-1) += a[0, na) * b[0, nb)
+      template <typename T>
+      void schoolbook_mult_add(T const *a, std::size_t na,
+                               T const *b, std::size_t nb,
+                               T *out)
+      {
+        schoolbook_mult_range_add(a, na, b, nb, out, 0, na + nb - 1);
+      }
+
+      // scratch space needed by karatsuba_square for operands of length n
+      inline std::size_t karatsuba_scratch(std::size_t n)
+      {
+        std::size_t s = 0;
+        while (n > karatsuba_cutoff)
+        {
+          n = (n + 1) / 2;
+          s += 4 * n;
+        }
+        return s;
+      }
+
+      // out[0, 2n-1) = a[0, n) * b[0, n)
+      template <typename T>
+      void karatsuba_square(T const *a, T const *b, std::size_t n,
+                            T *out, T *scratch)
+      {
+        if (n <= karatsuba_cutoff)
+        {
+          std::fill(out, out + 2*n - 1, T{});
+          schoolbook_mult_add(a, n, b, n, out);
+          return;
+        }
+
+        // a = a0 + a1.x^m, b = b0 + b1.x^m
+        std::size_t m = (n + 1) / 2;
+        std::size_t h = n - m;
+
+        // z0 = a0.b0 and z2 = a1.b1 go straight into place
+        T *sa = scratch;
+        T *sb = scratch + m;
+        T *z1 = scratch + 2*m;
+        karatsuba_square(a, b, m, out, scratch);
+        out[2*m - 1] = T{};
+        karatsuba_square(a + m, b + m, h, out + 2*m, z1);
+
+        // z1 = (a0 + a1)(b0 + b1) - z0 - z2
+        for (std::size_t i = 0; i < m; ++i)
+        {
+          sa[i] = i < h ? a[i] + a[m + i] : a[i];
+          sb[i] = i < h ? b[i] + b[m + i] : b[i];
+        }
+        karatsuba_square(sa, sb, m, z1, scratch + 4*m);
+        for (std::size_t i = 0; i < 2*m - 1; ++i)
+          z1[i] -= out[i];
+        for (std::size_t i = 0; i < 2*h - 1; ++i)
+          z1[i] -= out[2*m + i];
+        for (std::size_t i = 0; i < 2*m - 1; ++i)
+          out[m + i] += z1[i];
+      }
+
+      // out[0, na+nb-1) = a[0, na) * b[0, nb)
+      // Unbalanced operands are cut into slices the size of the shorter one
+      // so that every recursive product is square.
+      template <typename T>
+      void karatsuba_mult(T const *a, std::size_t na,
+                          T const *b, std::size_t nb,
+                          T *out)
+      {
+        if (na == 0 || nb == 0)
+          return;
+        std::fill(out, out + na + nb - 1, T{});
+        if (na < nb)
+        {
+          std::swap(a, b);
+          std::swap(na, nb);
+        }
+        if (nb <= karatsuba_cutoff)
+        {
+          schoolbook_mult_add(a, na, b, nb, out);
+          return;
+        }
+
+        std::vector<T> scratch(karatsuba_scratch(nb));
+        std::vector<T> slice(2*nb - 1);
+        for (std::size_t off = 0; off < na; off += nb)
+        {
+          std::size_t len = std::min(nb, na - off);
+          if (len == nb)
+            karatsuba_square(a + off, b, nb, slice.data(), scratch.data());
+          else
+            karatsuba_mult(b, nb, a + off, len, slice.data());
+          for (std::size_t i = 0; i < len + nb - 1; ++i)
+            out[off + i] += slice[i];
+        }
+      }
+
+      // out[0, n) += the low n coefficients of a[0, na) * b[0, nb)
+      template <typename T>
+      void schoolbook_mult_low_add(T const *a, std::size_t na,
+                                   T const *b, std::size_t nb,
+                                   T *out, std::size_t n)
+      {
+        schoolbook_mult_range_add(a, na, b, nb, out, 0, n);
+      }
+
+      // Mulders' short product: with a = a0 + a1.x^m and b = b0 + b1.x^m
+      // for m >= n/2, a.b mod x^n is the full a0.b0 plus x^m times the
+      // cross terms a0.b1 + a1.b0, themselves short products of length
+      // n - m. m ~ 0.7n is best for Karatsuba, saving about a fifth of the
+      // full product (the schoolbook short product saves half).
+      template <typename T>
+      void karatsuba_mult_low_add(T const *a, std::size_t na,
+                                  T const *b, std::size_t nb,
+                                  T *out, std::size_t n)
+      {
+        na = std::min(na, n);
+        nb = std::min(nb, n);
+        if (na == 0 || nb == 0)
+          return;
+        if (std::min(na, nb) <= karatsuba_cutoff)
+        {
+          schoolbook_mult_low_add(a, na, b, nb, out, n);
+          return;
+        }
+
+        std::size_t m = (7*n + 9) / 10;
+        std::size_t ma = std::min(na, m);
+        std::size_t mb = std::min(nb, m);
+        std::vector<T> z0(ma + mb - 1);
+        karatsuba_mult(a, ma, b, mb, z0.data());
+        for (std::size_t i = 0; i < z0.size() && i < n; ++i)
+          out[i] += z0[i];
+        if (nb > m)
+          karatsuba_mult_low_add(a, na, b + m, nb - m, out + m, n - m);
+        if (na > m)
+          karatsuba_mult_low_add(a + m, na - m, b, nb, out + m, n - m);
+      }
+
+      // out[0, n) = the low n coefficients of a[0, na) * b[0, nb)
+      template <typename T>
+      void karatsuba_mult_low(T const *a, std::size_t na,
+                              T const *b, std::size_t nb,
+                              T *out, std::size_t n)
+      {
+        std::fill(out, out + n, T{});
+        karatsuba_mult_low_add(a, na, b, nb, out, n);
+      }
+
+      // out[0, hi-lo) = coefficients [lo, hi) of a[0, na) * b[0, nb), for
+      // hi <= na + nb - 1
+      template <typename T>
+      void karatsuba_mult_range(T const *a, std::size_t na,
+                                T const *b, std::size_t nb,
+                                T *out, std::size_t lo, std::size_t hi)
+      {
+        if (lo == 0)
+        {
+          karatsuba_mult_low(a, na, b, nb, out, hi);
+          return;
+        }
+        if (std::min(na, nb) <= karatsuba_cutoff)
+        {
+          std::fill(out, out + (hi - lo), T{});
+          schoolbook_mult_range_add(a, na, b, nb, out, lo, hi);
+          return;
+        }
+        std::vector<T> low(hi);
+        karatsuba_mult_low(a, na, b, nb, low.data(), hi);
+        std::copy(low.begin() + static_cast<std::ptrdiff_t>(lo), low.end(), out);
+      }
+    } // namespace detail
+  }  // inline namespace v3
+} // namespace ranges
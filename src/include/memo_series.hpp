@@ -0,0 +1,298 @@
+#pragma once
+
+#include <range/v3/core.hpp>
+#include <range/v3/view/all.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace ranges
+{
+  inline namespace v3
+  {
+    namespace detail
+    {
+      // Append-only coefficient cache shared by every copy of a memo_series.
+      //
+      // Chunk k holds first_chunk << k coefficients, so a fixed directory of
+      // chunk pointers covers any length and nothing moves once written.
+      // Writers fill and publish under the mutex; readers of coefficients
+      // below the published count never lock.
+      template <typename T>
+      struct memo_state
+      {
+      private:
+        static constexpr std::size_t first_chunk = 64;
+        static constexpr std::size_t max_chunks = 48;
+
+        std::recursive_mutex own_mutex_;
+        std::recursive_mutex *mutex_;
+        std::atomic<std::size_t> count_;
+        bool exhausted_;
+        bool busy_;
+        std::array<T *, max_chunks> chunks_;
+        std::vector<std::unique_ptr<T[]>> owned_;
+
+        static std::size_t chunk_of(std::size_t n, std::size_t &offset)
+        {
+          std::size_t q = n / first_chunk + 1;
+          std::size_t k = 0;
+          while (q >>= 1)
+            ++k;
+          offset = n - first_chunk * ((std::size_t{1} << k) - 1);
+          return k;
+        }
+
+        void store(std::size_t n, T x)
+        {
+          std::size_t offset;
+          std::size_t k = chunk_of(n, offset);
+          if (offset == 0)
+          {
+            owned_.emplace_back(new T[first_chunk << k]());
+            chunks_[k] = owned_.back().get();
+          }
+          chunks_[k][offset] = std::move(x);
+        }
+
+        // the next coefficient of the underlying series, or false at its end
+        virtual bool pull(T &x) = 0;
+
+      public:
+        memo_state()
+          : mutex_{&own_mutex_}
+          , count_{0}
+          , exhausted_{false}
+          , busy_{false}
+          , chunks_{}
+        {}
+        memo_state(memo_state const &) = delete;
+        memo_state &operator=(memo_state const &) = delete;
+        virtual ~memo_state() = default;
+
+        // Series that are defined in terms of each other must fill under one
+        // lock, or two threads could each hold one and wait for the other.
+        void share_mutex(memo_state &that)
+        {
+          mutex_ = that.mutex_;
+        }
+
+        // make coefficient n available; false if the series is shorter
+        bool reach(std::size_t n)
+        {
+          if (n < count_.load(std::memory_order_acquire))
+            return true;
+          std::lock_guard<std::recursive_mutex> lock{*mutex_};
+          std::size_t count = count_.load(std::memory_order_relaxed);
+          while (count <= n && !exhausted_)
+          {
+            // computing a coefficient asked for itself (or a later one)
+            RANGES_ASSERT(!busy_);
+            busy_ = true;
+            T x{};
+            bool more = pull(x);
+            busy_ = false;
+            if (!more)
+            {
+              exhausted_ = true;
+              break;
+            }
+            store(count, std::move(x));
+            count_.store(++count, std::memory_order_release);
+          }
+          return n < count;
+        }
+
+        // only valid for n that reach has returned true for
+        T const &operator[](std::size_t n) const
+        {
+          std::size_t offset;
+          std::size_t k = chunk_of(n, offset);
+          return chunks_[k][offset];
+        }
+      };
+
+      // Reads a range one coefficient at a time. The underlying cursor is only
+      // advanced when the next coefficient is wanted, never straight after
+      // producing one, so a series defined in terms of itself is never asked
+      // for a coefficient before it is stored.
+      template <typename T, typename Rng>
+      struct memo_reader
+      {
+      private:
+        Rng rng_;
+        range_iterator_t<Rng> it_;
+        bool started_;
+
+      public:
+        explicit memo_reader(Rng rng)
+          : rng_(std::move(rng))
+          , started_{false}
+        {}
+        bool operator()(T &x)
+        {
+          if (started_)
+            ++it_;
+          else
+          {
+            it_ = begin(rng_);
+            started_ = true;
+          }
+          if (it_ == end(rng_))
+            return false;
+          x = *it_;
+          return true;
+        }
+      };
+
+      template <typename T, typename Rng>
+      struct memo_source
+        : memo_state<T>
+      {
+      private:
+        memo_reader<T, Rng> read_;
+
+        bool pull(T &x) override
+        {
+          return read_(x);
+        }
+
+      public:
+        explicit memo_source(Rng rng)
+          : read_{std::move(rng)}
+        {}
+      };
+
+      // A series whose definition is supplied after it is created, so that
+      // the definition can refer to the series itself.
+      template <typename T>
+      struct memo_deferred
+        : memo_state<T>
+      {
+      private:
+        std::function<bool(T &)> read_;
+
+        bool pull(T &x) override
+        {
+          RANGES_ASSERT(read_);
+          return read_(x);
+        }
+
+      public:
+        template <typename Rng>
+        void define(Rng rng)
+        {
+          read_ = memo_reader<T, Rng>{std::move(rng)};
+        }
+      };
+    } // namespace detail
+
+    // A series whose coefficients are each computed at most once, however
+    // many copies, cursors and threads read it. References to coefficients
+    // stay valid for as long as any copy of the series is alive.
+    template <typename T>
+    struct memo_series
+      : view_facade<memo_series<T>, unknown>
+    {
+    private:
+      friend range_access;
+      std::shared_ptr<detail::memo_state<T>> state_;
+
+      struct cursor
+      {
+        using difference_type = std::ptrdiff_t;
+      private:
+        detail::memo_state<T> *state_;
+        difference_type n_;
+
+        std::size_t index() const
+        {
+          return static_cast<std::size_t>(n_);
+        }
+      public:
+        cursor() = default;
+        cursor(detail::memo_state<T> &state)
+          : state_{&state}
+          , n_{0}
+        {}
+        T const &current() const
+        {
+          state_->reach(index());
+          return (*state_)[index()];
+        }
+        bool done() const
+        {
+          return !state_->reach(index());
+        }
+        void next()
+        {
+          ++n_;
+        }
+        void prev()
+        {
+          --n_;
+        }
+        void advance(difference_type n)
+        {
+          n_ += n;
+        }
+        bool equal(cursor const &that) const
+        {
+          return n_ == that.n_;
+        }
+        difference_type distance_to(cursor const &that) const
+        {
+          return that.n_ - n_;
+        }
+      };
+
+      cursor begin_cursor() const
+      {
+        return {*state_};
+      }
+
+    public:
+      memo_series() = default;
+      explicit memo_series(std::shared_ptr<detail::memo_state<T>> state)
+        : state_{std::move(state)}
+      {}
+    };
+
+    namespace view
+    {
+      struct memoize_fn
+      {
+        template<typename Rng,
+                 CONCEPT_REQUIRES_(InputRange<Rng>())>
+        memo_series<range_value_t<Rng>> operator()(Rng && r) const
+        {
+          using T = range_value_t<Rng>;
+          return memo_series<T>{
+            std::make_shared<detail::memo_source<T, all_t<Rng>>>(
+                all(std::forward<Rng>(r)))};
+        }
+
+#ifndef RANGES_DOXYGEN_INVOKED
+        template<typename Rng,
+                 CONCEPT_REQUIRES_(!InputRange<Rng>())>
+        void operator()(Rng && r) const
+        {
+          CONCEPT_ASSERT_MSG(
+              InputRange<Rng>(),
+              "The range passed to view::memoize must model the InputRange concept.");
+        }
+#endif
+      };
+
+      namespace
+      {
+        constexpr auto&& memoize = static_const<memoize_fn>::value;
+      }
+    }
+  }
+}
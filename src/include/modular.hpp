@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdint>
+
+namespace power_series
+{
+  // Integers modulo the prime M, for exact series arithmetic. With an
+  // NTT-friendly M (such as 998244353) products go straight through the
+  // number-theoretic transform.
+  template <std::uint32_t M>
+  struct modular
+  {
+  private:
+    // sums of two residues must fit in 32 bits
+    static_assert(M > 1 && M < (std::uint32_t{1} << 31),
+                  "modular needs a modulus between 2 and 2^31");
+    std::uint32_t v_;
+
+    static constexpr std::uint32_t reduce(std::int64_t x)
+    {
+      x %= static_cast<std::int64_t>(M);
+      return static_cast<std::uint32_t>(x < 0 ? x + M : x);
+    }
+
+  public:
+    static constexpr std::uint32_t modulus = M;
+
+    constexpr modular()
+      : v_{0}
+    {}
+    constexpr modular(std::int64_t x)
+      : v_{reduce(x)}
+    {}
+
+    constexpr std::uint32_t value() const
+    {
+      return v_;
+    }
+
+    modular &operator+=(modular that)
+    {
+      v_ += that.v_;
+      if (v_ >= M) v_ -= M;
+      return *this;
+    }
+    modular &operator-=(modular that)
+    {
+      v_ = v_ >= that.v_ ? v_ - that.v_ : v_ + M - that.v_;
+      return *this;
+    }
+    modular &operator*=(modular that)
+    {
+      v_ = static_cast<std::uint32_t>(
+          static_cast<std::uint64_t>(v_) * that.v_ % M);
+      return *this;
+    }
+    modular &operator/=(modular that)
+    {
+      return *this *= that.inverse();
+    }
+
+    modular pow(std::uint64_t e) const
+    {
+      modular r{1};
+      modular b{*this};
+      for (; e > 0; e >>= 1, b *= b)
+        if (e & 1) r *= b;
+      return r;
+    }
+    // M is prime, so x^(M-2) is the inverse of any non-zero x
+    modular inverse() const
+    {
+      return pow(M - 2);
+    }
+
+    friend modular operator+(modular a, modular b) { return a += b; }
+    friend modular operator-(modular a, modular b) { return a -= b; }
+    friend modular operator*(modular a, modular b) { return a *= b; }
+    friend modular operator/(modular a, modular b) { return a /= b; }
+    friend modular operator-(modular a) { return modular{} -= a; }
+    friend bool operator==(modular a, modular b) { return a.v_ == b.v_; }
+    friend bool operator!=(modular a, modular b) { return a.v_ != b.v_; }
+  };
+}
@@ -1,7 +1,17 @@
 #pragma once
 
+#include "series_fill.hpp"
+
 #include <range/v3/view/zip_with.hpp>
 
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <limits>
+#include <tuple>
+#include <utility>
+#include <vector>
+
 namespace ranges
 {
   inline namespace v3
@@ -18,6 +28,25 @@ namespace ranges
               C1::value >= 0 && C2::value >= 0 ?
                 max_(C1::value, C2::value) :
                 finite>;
+
+      template<typename... Cs>
+      struct nary_monoidal_zip_cardinality;
+      template<typename C>
+      struct nary_monoidal_zip_cardinality<C>
+        : C
+      {};
+      template<typename C1, typename C2, typename... Cs>
+      struct nary_monoidal_zip_cardinality<C1, C2, Cs...>
+        : nary_monoidal_zip_cardinality<monoidal_zip_cardinality<C1, C2>, Cs...>
+      {};
+
+      // f(std::integral_constant<std::size_t, I>{}) for each I in order
+      template<typename F, std::size_t... I>
+      void for_each_index(F &&f, std::index_sequence<I...>)
+      {
+        (void) std::initializer_list<int>{
+          (f(std::integral_constant<std::size_t, I>{}), 0)...};
+      }
     } // namespace detail
 
     template<typename Fun, typename R1, typename R2>
@@ -36,6 +65,26 @@ namespace ranges
                                              range_difference_t<R2>>;
       using size_type_ = meta::eval<std::make_unsigned<difference_type_>>;
 
+      // cursors jump in O(1) over random-access ranges whose ends are known
+      using are_random_access_t =
+        meta::and_c<(bool) RandomAccessRange<R1>(),
+                    (bool) RandomAccessRange<R2>(),
+                    (bool) SizedRange<R1>() || range_cardinality<R1>::value == infinite,
+                    (bool) SizedRange<R2>() || range_cardinality<R2>::value == infinite>;
+
+      template <typename Rng>
+      using is_sized_t = std::integral_constant<bool, (bool) SizedRange<Rng>()>;
+      template <typename Rng>
+      static difference_type_ extent(Rng &r, std::true_type)
+      {
+        return static_cast<difference_type_>(ranges::size(r));
+      }
+      template <typename Rng>
+      static difference_type_ extent(Rng &, std::false_type)
+      {
+        return std::numeric_limits<difference_type_>::max();
+      }
+
       template <bool IsConst>
       struct sentinel;
 
@@ -139,12 +188,35 @@ namespace ranges
           --it1_;
           --it2_;
         }
-        CONCEPT_REQUIRES(meta::and_c<(bool) RandomAccessRange<R1>(),
-                                     (bool) RandomAccessRange<R2>()>::value)
+        // The element index, which is how far the further iterator has
+        // gone: the other stops at the end of its range.
+        difference_type position() const
+        {
+          return detail::max_(
+              static_cast<difference_type>(detail::distance_to(begin(rng_->r1_), it1_)),
+              static_cast<difference_type>(detail::distance_to(begin(rng_->r2_), it2_)));
+        }
+        CONCEPT_REQUIRES(are_random_access_t::value)
+        void advance(difference_type n)
+        {
+          difference_type p = position() + n;
+          difference_type n1 = extent(rng_->r1_, is_sized_t<R1>{});
+          difference_type n2 = extent(rng_->r2_, is_sized_t<R2>{});
+          difference_type i1 = detail::min_(p, n1);
+          difference_type i2 = detail::min_(p, n2);
+          it1_ = begin(rng_->r1_) + i1;
+          it2_ = begin(rng_->r2_) + i2;
+          // as next() would leave it: one more than the number of elements
+          // since the shorter range ended
+          diff_ = p < n1 && p < n2 ? 0 :
+            n1 > n2 ? p - n2 + 1 :
+            n2 > n1 ? -(p - n1 + 1) :
+            0;
+        }
+        CONCEPT_REQUIRES(are_random_access_t::value)
         difference_type distance_to(cursor const &that) const
         {
-          return detail::max_(detail::distance_to(it1_, that.it1_),
-                              detail::distance_to(it2_, that.it2_));
+          return that.position() - position();
         }
       };
 
@@ -208,6 +280,14 @@ namespace ranges
         , r1_{std::move(r1)}
         , r2_{std::move(r2)}
       {}
+      R1 const &base1() const
+      {
+        return r1_;
+      }
+      R2 const &base2() const
+      {
+        return r2_;
+      }
       CONCEPT_REQUIRES(meta::and_c<(bool) SizedRange<R1>(),
                                    (bool) SizedRange<R2>()>::value)
       constexpr size_type_ size() const
@@ -217,6 +297,28 @@ namespace ranges
                                                range_cardinality<R2>::value)) :
           detail::max_(ranges::size(r1_), ranges::size(r2_));
       }
+      // Both inputs in bulk, then fun over the two arrays, which vectorizes
+      // for arithmetic. Pointers stand in for the iterators, so this is
+      // there when fun takes them, as monoidal_zip_view's does.
+      template<typename T,
+               typename V1 = range_value_t<R1>,
+               typename V2 = range_value_t<R2>,
+               CONCEPT_REQUIRES_(Range<R1 const>() && Range<R2 const>())>
+      auto fill(T *out, std::size_t n) const
+        -> decltype(fun_(std::declval<V1 const *>(), std::declval<V2 const *>()),
+                    std::size_t{})
+      {
+        std::vector<V1> a(n);
+        a.resize(series_fill(r1_, a.data(), n));
+        std::vector<V2> b(n);
+        b.resize(series_fill(r2_, b.data(), n));
+        std::size_t k = std::min(a.size(), b.size());
+        for (std::size_t i = 0; i < k; ++i)
+          out[i] = fun_(&a[i], &b[i]);
+        std::copy(a.begin() + static_cast<std::ptrdiff_t>(k), a.end(), out + k);
+        std::copy(b.begin() + static_cast<std::ptrdiff_t>(k), b.end(), out + k);
+        return std::max(a.size(), b.size());
+      }
     };
 
     template<typename Fun, typename R1, typename R2>
@@ -234,6 +336,155 @@ namespace ranges
       {}
     };
 
+    // monoidal_zip of three or more ranges in one flat cursor: each step
+    // advances every range not yet at its end, and each element folds fun
+    // over the elements of those ranges, left to right. Nesting the binary
+    // view instead would cost a cursor, and its bookkeeping, per range.
+    template<typename Fun, typename... Rngs>
+    struct nary_monoidal_zip_view
+      : view_facade<nary_monoidal_zip_view<Fun, Rngs...>,
+                    detail::nary_monoidal_zip_cardinality<
+                      range_cardinality<Rngs>...>::value>
+    {
+    private:
+      friend range_access;
+      semiregular_t<function_type<Fun>> fun_;
+      std::tuple<Rngs...> rngs_;
+
+      using indices_t = std::index_sequence_for<Rngs...>;
+      using difference_type_ = common_type_t<range_difference_t<Rngs>...>;
+      using size_type_ = meta::eval<std::make_unsigned<difference_type_>>;
+      using value_type_ = common_type_t<range_value_t<Rngs>...>;
+
+      template <bool IsConst>
+      struct sentinel;
+
+      template <bool IsConst>
+      struct cursor
+      {
+        using difference_type = difference_type_;
+      private:
+        friend struct sentinel<IsConst>;
+        template <typename T>
+        using constify_if = meta::apply<meta::add_const_if_c<IsConst>, T>;
+        using monoidal_zip_view_t = constify_if<nary_monoidal_zip_view>;
+        monoidal_zip_view_t *rng_;
+        std::tuple<range_iterator_t<constify_if<Rngs>>...> its_;
+
+        template <std::size_t I>
+        bool done(std::integral_constant<std::size_t, I>) const
+        {
+          return std::get<I>(its_) == end(std::get<I>(rng_->rngs_));
+        }
+
+      public:
+        using single_pass = meta::or_<SinglePass<range_iterator_t<Rngs>>...>;
+
+        cursor() = default;
+        cursor(monoidal_zip_view_t &rng, begin_tag)
+          : rng_{&rng}
+          , its_{begin_all(rng, indices_t{})}
+        {}
+        template <std::size_t... I>
+        static std::tuple<range_iterator_t<constify_if<Rngs>>...>
+        begin_all(monoidal_zip_view_t &rng, std::index_sequence<I...>)
+        {
+          return std::tuple<range_iterator_t<constify_if<Rngs>>...>{
+            begin(std::get<I>(rng.rngs_))...};
+        }
+        value_type_ current() const
+        {
+          value_type_ acc{};
+          bool first = true;
+          detail::for_each_index([&] (auto i) {
+              if (this->done(i))
+                return;
+              if (first)
+                acc = *std::get<decltype(i)::value>(its_);
+              else
+                acc = rng_->fun_(std::move(acc), *std::get<decltype(i)::value>(its_));
+              first = false;
+            }, indices_t{});
+          return acc;
+        }
+        void next()
+        {
+          detail::for_each_index([&] (auto i) {
+              if (!this->done(i))
+                ++std::get<decltype(i)::value>(its_);
+            }, indices_t{});
+        }
+        bool equal(cursor const &that) const
+        {
+          return its_ == that.its_;
+        }
+      };
+
+      template <bool IsConst>
+      struct sentinel
+      {
+      private:
+        template <typename T>
+        using constify_if = meta::apply<meta::add_const_if_c<IsConst>, T>;
+      public:
+        sentinel() = default;
+        sentinel(constify_if<nary_monoidal_zip_view> &, end_tag)
+        {}
+        bool equal(cursor<IsConst> const &pos) const
+        {
+          bool all = true;
+          detail::for_each_index([&] (auto i) {
+              all = all && pos.done(i);
+            }, indices_t{});
+          return all;
+        }
+      };
+
+      cursor<false> begin_cursor()
+      {
+        return {*this, begin_tag{}};
+      }
+      sentinel<false> end_cursor()
+      {
+        return {*this, end_tag{}};
+      }
+      CONCEPT_REQUIRES(meta::and_c<(bool) Range<Rngs const>()...>::value)
+      cursor<true> begin_cursor() const
+      {
+        return {*this, begin_tag{}};
+      }
+      CONCEPT_REQUIRES(meta::and_c<(bool) Range<Rngs const>()...>::value)
+      sentinel<true> end_cursor() const
+      {
+        return {*this, end_tag{}};
+      }
+
+      template <std::size_t... I>
+      size_type_ max_size(std::index_sequence<I...>) const
+      {
+        size_type_ n = 0;
+        (void) std::initializer_list<int>{
+          (n = detail::max_(n, static_cast<size_type_>(
+                                   ranges::size(std::get<I>(rngs_)))), 0)...};
+        return n;
+      }
+    public:
+      nary_monoidal_zip_view() = default;
+      explicit nary_monoidal_zip_view(Fun fun, Rngs... rngs)
+        : fun_(as_function(std::move(fun)))
+        , rngs_{std::move(rngs)...}
+      {}
+      std::tuple<Rngs...> const &bases() const
+      {
+        return rngs_;
+      }
+      CONCEPT_REQUIRES(meta::and_c<(bool) SizedRange<Rngs>()...>::value)
+      size_type_ size() const
+      {
+        return max_size(indices_t{});
+      }
+    };
+
     namespace view
     {
       struct iter_monoidal_zip_fn
@@ -319,6 +570,46 @@ namespace ranges
               "of the ranges' reference types.");
         }
 #endif
+
+        template<typename Fun, typename... Rngs>
+        using NaryConcept = meta::and_<
+          InputRange<Rngs>...,
+          Callable<Fun, common_type_t<range_value_t<Rngs>...> &&,
+                   range_reference_t<Rngs> &&>...>;
+
+        template<typename R1, typename R2, typename R3, typename... Rs, typename Fun,
+                 CONCEPT_REQUIRES_(NaryConcept<Fun, R1, R2, R3, Rs...>())>
+        nary_monoidal_zip_view<Fun, all_t<R1>, all_t<R2>, all_t<R3>, all_t<Rs>...>
+        operator()(Fun fun, R1 && r1, R2 && r2, R3 && r3, Rs &&... rs) const
+        {
+          return nary_monoidal_zip_view<Fun, all_t<R1>, all_t<R2>, all_t<R3>,
+                                        all_t<Rs>...>{
+              std::move(fun),
+              all(std::forward<R1>(r1)),
+              all(std::forward<R2>(r2)),
+              all(std::forward<R3>(r3)),
+              all(std::forward<Rs>(rs))...
+          };
+        }
+
+#ifndef RANGES_DOXYGEN_INVOKED
+        template<typename R1, typename R2, typename R3, typename... Rs, typename Fun,
+                 CONCEPT_REQUIRES_(!NaryConcept<Fun, R1, R2, R3, Rs...>())>
+        void operator()(Fun, R1 &&, R2 &&, R3 &&, Rs &&...) const
+        {
+          CONCEPT_ASSERT_MSG(meta::and_<InputRange<R1>, InputRange<R2>,
+                                        InputRange<R3>, InputRange<Rs>...>(),
+                             "All of the objects passed to view::monoidal_zip must model "
+                             "the InputRange concept");
+          CONCEPT_ASSERT_MSG(
+              meta::and_<Callable<Fun,
+                                  common_type_t<range_value_t<R1>, range_value_t<R2>,
+                                                range_value_t<R3>, range_value_t<Rs>...> &&,
+                                  range_reference_t<R1> &&>>(),
+              "The function passed to view::monoidal_zip must be callable with the "
+              "ranges' common value type and each of their reference types.");
+        }
+#endif
       };
 
       namespace
@@ -0,0 +1,436 @@
+#pragma once
+
+#include "series_mult.hpp"
+#include "simd.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+// Truncated series arithmetic on coefficient vectors. Everything here
+// works to a fixed number of terms and leans on the fast products in
+// series_mult.hpp, so that Newton iteration (which doubles the number of
+// correct terms each step) costs a constant number of multiplications.
+
+namespace power_series
+{
+  namespace detail
+  {
+    // whether x has an inverse in T: integers have only 1 and -1, where
+    // T{1} / x is exact
+    template <typename T>
+    bool is_unit(T const& x, std::true_type)
+    {
+      return x == T{1} || (std::is_signed<T>::value && x == static_cast<T>(-1));
+    }
+
+    template <typename T>
+    bool is_unit(T const& x, std::false_type)
+    {
+      return x != T{};
+    }
+
+    template <typename T>
+    bool is_unit(T const& x)
+    {
+      return is_unit(x, std::is_integral<T>{});
+    }
+
+    // the first n coefficients of a * b
+    template <typename T>
+    std::vector<T> mul(std::vector<T> const& a, std::vector<T> const& b,
+                       std::size_t n)
+    {
+      std::vector<T> c(n);
+      ranges::detail::series_mult_low(
+          a.data(), a.size(), b.data(), b.size(), c.data(), n,
+          ranges::series_mult_strategy::automatic{});
+      return c;
+    }
+
+    // coefficients [lo, hi) of a * b
+    template <typename T>
+    std::vector<T> mul_middle(std::vector<T> const& a, std::vector<T> const& b,
+                              std::size_t lo, std::size_t hi)
+    {
+      std::vector<T> c(hi - lo);
+      ranges::detail::series_mult_middle(
+          a.data(), a.size(), b.data(), b.size(), c.data(), lo, hi,
+          ranges::series_mult_strategy::automatic{});
+      return c;
+    }
+
+    // The first n coefficients of 1/f. Each step takes g = 1/f + O(x^k) to
+    // g - g(fg - 1) = 1/f + O(x^2k); fg - 1 vanishes below x^k, so only its
+    // upper half is computed (as a middle product) and multiplied back in
+    // (as a short product). f[0] must be invertible in T (see is_unit).
+    template <typename T>
+    std::vector<T> reciprocal(std::vector<T> const& f, std::size_t n)
+    {
+      RANGES_ASSERT(!f.empty() && detail::is_unit(f[0]));
+      std::vector<T> g{T{1} / f[0]};
+      for (std::size_t k = 1; k < n; k *= 2)
+      {
+        std::size_t m = std::min(2*k, n);
+        std::vector<T> fm(f.begin(), f.begin() + static_cast<std::ptrdiff_t>(
+                              std::min(m, f.size())));
+        auto high = detail::mul_middle(fm, g, k, m);
+        auto d = detail::mul(g, high, m - k);
+        g.resize(m);
+        for (std::size_t i = 0; i < m - k; ++i)
+          g[k + i] -= d[i];
+      }
+      g.resize(n);
+      return g;
+    }
+
+    // the first n coefficients of a/b
+    template <typename T>
+    std::vector<T> divide(std::vector<T> const& a, std::vector<T> const& b,
+                          std::size_t n)
+    {
+      return detail::mul(a, detail::reciprocal(b, n), n);
+    }
+
+    template <typename T>
+    T from_integer(std::uint64_t i)
+    {
+      return static_cast<T>(static_cast<std::int64_t>(i));
+    }
+
+    // the coefficients of a', one fewer than a
+    template <typename T>
+    std::vector<T> derivative(std::vector<T> const& a)
+    {
+      std::vector<T> d(a.empty() ? 0 : a.size() - 1);
+      for (std::size_t i = 1; i < a.size(); ++i)
+        d[i - 1] = a[i] * detail::from_integer<T>(i);
+      return d;
+    }
+
+    // the first n coefficients of the integral of a, from 0
+    template <typename T>
+    std::vector<T> integral(std::vector<T> const& a, std::size_t n)
+    {
+      std::vector<T> r(n);
+      for (std::size_t i = 1; i < n && i <= a.size(); ++i)
+        r[i] = a[i - 1] / detail::from_integer<T>(i);
+      return r;
+    }
+
+    // the first n coefficients of log f = integral of f'/f; f[0] must be 1
+    template <typename T>
+    std::vector<T> log(std::vector<T> const& f, std::size_t n)
+    {
+      RANGES_ASSERT(!f.empty() && f[0] == T{1});
+      if (n == 0)
+        return {};
+      std::vector<T> fn(f.begin(), f.begin() + static_cast<std::ptrdiff_t>(
+                            std::min(n, f.size())));
+      return detail::integral(
+          detail::divide(detail::derivative(fn), fn, n - 1), n);
+    }
+
+    // The first n coefficients of exp f; f[0] must be 0. Newton on
+    // log g = f takes g to g(1 + f - log g), and f - log g vanishes below
+    // x^k, so again only its upper half is multiplied back in.
+    template <typename T>
+    std::vector<T> exp(std::vector<T> const& f, std::size_t n)
+    {
+      RANGES_ASSERT(f.empty() || f[0] == T{});
+      std::vector<T> g{T{1}};
+      for (std::size_t k = 1; k < n; k *= 2)
+      {
+        std::size_t m = std::min(2*k, n);
+        auto l = detail::log(g, m);
+        std::vector<T> high(m - k);
+        for (std::size_t i = k; i < m; ++i)
+          high[i - k] = (i < f.size() ? f[i] : T{}) - l[i];
+        auto d = detail::mul(g, high, m - k);
+        g.resize(m);
+        for (std::size_t i = 0; i < m - k; ++i)
+          g[k + i] += d[i];
+      }
+      g.resize(n);
+      return g;
+    }
+
+    template <typename T>
+    T power(T c, std::uint64_t e)
+    {
+      T r{1};
+      for (; e > 0; e >>= 1, c *= c)
+        if (e & 1) r *= c;
+      return r;
+    }
+
+    // The first n coefficients of f^e. Writing f = c.x^s.h with h[0] = 1,
+    // this is c^e.x^(se).exp(e.log h), so f may start with zeros.
+    template <typename T>
+    std::vector<T> pow(std::vector<T> const& f, std::uint64_t e, std::size_t n)
+    {
+      std::vector<T> r(n);
+      if (n == 0)
+        return r;
+      if (e == 0)
+      {
+        r[0] = T{1};
+        return r;
+      }
+      std::size_t s = 0;
+      while (s < f.size() && f[s] == T{})
+        ++s;
+      if (s == f.size() || (s > 0 && e > (n - 1) / s))
+        return r;
+      std::size_t shift = s * static_cast<std::size_t>(e);
+      std::size_t m = n - shift;
+      T c = f[s];
+      std::vector<T> h(std::min(m, f.size() - s));
+      for (std::size_t i = 0; i < h.size(); ++i)
+        h[i] = f[s + i] / c;
+      auto l = detail::log(h, m);
+      T te = detail::from_integer<T>(e);
+      for (auto& x : l)
+        x *= te;
+      auto g = detail::exp(l, m);
+      T ce = detail::power(c, e);
+      for (std::size_t i = 0; i < m; ++i)
+        r[shift + i] = ce * g[i];
+      return r;
+    }
+
+    // the first n coefficients of f^alpha for real alpha; f[0] must be
+    // positive
+    template <typename T,
+              typename std::enable_if<std::is_floating_point<T>::value, int>::type = 0>
+    std::vector<T> pow(std::vector<T> const& f, T alpha, std::size_t n)
+    {
+      RANGES_ASSERT(!f.empty() && f[0] > T{});
+      if (n == 0)
+        return {};
+      T c = f[0];
+      std::vector<T> h(std::min(n, f.size()));
+      for (std::size_t i = 0; i < h.size(); ++i)
+        h[i] = f[i] / c;
+      auto l = detail::log(h, n);
+      for (auto& x : l)
+        x *= alpha;
+      auto g = detail::exp(l, n);
+      T ca = std::pow(c, alpha);
+      for (auto& x : g)
+        x *= ca;
+      return g;
+    }
+
+    template <typename T,
+              typename std::enable_if<std::is_floating_point<T>::value, int>::type = 0>
+    T sqrt_constant(T c)
+    {
+      RANGES_ASSERT(c > T{});
+      return std::sqrt(c);
+    }
+
+    // without a square root on T, only a constant term of 1 is supported
+    template <typename T,
+              typename std::enable_if<!std::is_floating_point<T>::value, int>::type = 0>
+    T sqrt_constant(T c)
+    {
+      RANGES_ASSERT(c == T{1});
+      return c;
+    }
+
+    // The first n coefficients of sqrt f, by Newton's g -> (g + f/g)/2.
+    // f[0] must have a square root in T.
+    template <typename T>
+    std::vector<T> sqrt(std::vector<T> const& f, std::size_t n)
+    {
+      RANGES_ASSERT(!f.empty());
+      std::vector<T> g{detail::sqrt_constant(f[0])};
+      T half = T{1} / T{2};
+      for (std::size_t k = 1; k < n; k *= 2)
+      {
+        std::size_t m = std::min(2*k, n);
+        std::vector<T> fm(f.begin(), f.begin() + static_cast<std::ptrdiff_t>(
+                              std::min(m, f.size())));
+        auto q = detail::divide(fm, g, m);
+        g.resize(m);
+        for (std::size_t i = 0; i < m; ++i)
+          g[i] = (g[i] + q[i]) * half;
+      }
+      g.resize(n);
+      return g;
+    }
+
+    // The first n coefficients of f(g); g[0] must be 0. Brent and Kung's
+    // baby-step/giant-step: with k ~ sqrt(n) and the powers g^0 .. g^k
+    // cached, f splits into blocks of k coefficients, each block is a
+    // linear combination of the cached powers, and the blocks are joined
+    // by Horner's rule in G = g^k. That is O(sqrt(n)) multiplications
+    // plus O(n^2) scalar work, where substituting term by term is O(n)
+    // multiplications.
+    template <typename T>
+    std::vector<T> compose(std::vector<T> const& f, std::vector<T> const& g,
+                           std::size_t n)
+    {
+      RANGES_ASSERT(g.empty() || g[0] == T{});
+      std::vector<T> r(n);
+      std::size_t nf = std::min(f.size(), n);
+      if (nf == 0)
+        return r;
+      std::size_t k = 1;
+      while (k * k < nf)
+        ++k;
+      std::vector<T> gn(g.begin(), g.begin() + static_cast<std::ptrdiff_t>(
+                            std::min(g.size(), n)));
+      std::vector<std::vector<T>> powers{std::vector<T>{T{1}}};
+      for (std::size_t i = 1; i <= k; ++i)
+        powers.push_back(detail::mul(powers.back(), gn, n));
+
+      std::size_t blocks = (nf + k - 1) / k;
+      for (std::size_t j = blocks; j-- > 0;)
+      {
+        if (j + 1 < blocks)
+          r = detail::mul(r, powers[k], n);
+        for (std::size_t i = 0; i < k && j*k + i < nf; ++i)
+        {
+          T c = f[j*k + i];
+          if (c == T{})
+            continue;
+          // g^i starts at x^i
+          auto const& p = powers[i];
+          for (std::size_t t = i; t < p.size(); ++t)
+            r[t] += c * p[t];
+        }
+      }
+      return r;
+    }
+
+    // The first n coefficients of the compositional inverse of f, the g
+    // with f(g) = x; f[0] must be 0 and f[1] invertible. Newton's
+    // g -> g - (f(g) - x)/f'(g) doubles the correct terms each step.
+    template <typename T>
+    std::vector<T> revert(std::vector<T> const& f, std::size_t n)
+    {
+      // g[0] is 0 and g[1] needs f[1], which f may not have been read to
+      if (n < 2)
+        return std::vector<T>(n);
+      RANGES_ASSERT(f.size() > 1 && f[0] == T{} && detail::is_unit(f[1]));
+      std::vector<T> g(2);
+      g[1] = T{1} / f[1];
+      auto df = detail::derivative(f);
+      for (std::size_t k = 2; k < n; k *= 2)
+      {
+        std::size_t m = std::min(2*k, n);
+        auto e = detail::compose(f, g, m);
+        e[1] -= T{1};
+        auto d = detail::divide(e, detail::compose(df, g, m), m);
+        g.resize(m);
+        for (std::size_t i = 0; i < m; ++i)
+          g[i] -= d[i];
+      }
+      return g;
+    }
+
+    // a mod b, for b with an invertible leading coefficient. The quotient
+    // is the reversal of rev(a)/rev(b) to deg a - deg b + 1 terms, so
+    // division costs a reciprocal and two products.
+    template <typename T>
+    std::vector<T> remainder(std::vector<T> const& a, std::vector<T> const& b)
+    {
+      std::size_t d = b.size() - 1;
+      if (a.size() <= d)
+        return a;
+      std::size_t k = a.size() - d;
+      std::vector<T> ra(a.rbegin(), a.rbegin() + static_cast<std::ptrdiff_t>(k));
+      std::vector<T> rb(b.rbegin(), b.rend());
+      auto rq = detail::divide(ra, rb, k);
+      std::vector<T> q(rq.rbegin(), rq.rend());
+      auto qb = detail::mul(q, b, d);
+      std::vector<T> r(d);
+      for (std::size_t i = 0; i < d; ++i)
+        r[i] = a[i] - qb[i];
+      return r;
+    }
+
+    // below this many points, remainders stop and Horner takes over
+    constexpr std::size_t subproduct_leaf = 64;
+
+    // The subproduct tree over xs[0, m): node i holds the product of the
+    // (x - xs[j]) under it, with its children at 2i + 1 and 2i + 2.
+    template <typename T>
+    void subproduct_tree(std::vector<std::vector<T>>& tree, std::size_t i,
+                         T const* xs, std::size_t m)
+    {
+      if (tree.size() <= i)
+        tree.resize(i + 1);
+      if (m <= subproduct_leaf)
+      {
+        std::vector<T> p{T{1}};
+        for (std::size_t j = 0; j < m; ++j)
+        {
+          p.push_back(T{});
+          for (std::size_t k = p.size() - 1; k > 0; --k)
+            p[k] = p[k - 1] - xs[j] * p[k];
+          p[0] = -(xs[j] * p[0]);
+        }
+        tree[i] = std::move(p);
+        return;
+      }
+      std::size_t h = m / 2;
+      detail::subproduct_tree(tree, 2*i + 1, xs, h);
+      detail::subproduct_tree(tree, 2*i + 2, xs + h, m - h);
+      auto& l = tree[2*i + 1];
+      auto& r = tree[2*i + 2];
+      auto p = detail::mul(l, r, l.size() + r.size() - 1);
+      tree[i] = std::move(p);
+    }
+
+    template <typename T>
+    void evaluate_tree(std::vector<std::vector<T>> const& tree, std::size_t i,
+                       std::vector<T> const& f, T const* xs, std::size_t m,
+                       T* out)
+    {
+      auto r = detail::remainder(f, tree[i]);
+      if (m <= subproduct_leaf)
+      {
+        ranges::detail::horner_many(r.data(), r.size(), xs, m, out);
+        return;
+      }
+      std::size_t h = m / 2;
+      detail::evaluate_tree(tree, 2*i + 1, r, xs, h, out);
+      detail::evaluate_tree(tree, 2*i + 2, r, xs + h, m - h, out + h);
+    }
+
+    // from here, the subproduct tree beats Horner on every point
+    constexpr std::size_t evaluate_tree_threshold = 4096;
+
+    // out[j] = f(xs[j]) for m points. Horner's rule is n.m multiply-adds;
+    // for exact coefficients, when both the degree and the number of
+    // points are large, f is instead reduced modulo the subproduct tree
+    // of the points, in O(M(m) log m). Floating point stays with Horner:
+    // the remainders lose all precision as the tree's coefficients grow.
+    template <typename T>
+    void evaluate_many(std::vector<T> const& f, T const* xs, std::size_t m,
+                       T* out, std::true_type)
+    {
+      ranges::detail::horner_many(f.data(), f.size(), xs, m, out);
+    }
+
+    template <typename T>
+    void evaluate_many(std::vector<T> const& f, T const* xs, std::size_t m,
+                       T* out, std::false_type)
+    {
+      if (f.size() < evaluate_tree_threshold || m < evaluate_tree_threshold)
+      {
+        ranges::detail::horner_many(f.data(), f.size(), xs, m, out);
+        return;
+      }
+      std::vector<std::vector<T>> tree;
+      detail::subproduct_tree(tree, 0, xs, m);
+      detail::evaluate_tree(tree, 0, f, xs, m, out);
+    }
+  }
+}
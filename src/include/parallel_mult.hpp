@@ -0,0 +1,58 @@
+#pragma once
+
+#include "simd.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace ranges
+{
+  inline namespace v3
+  {
+    namespace detail
+    {
+      // out[0, na+nb-1) = a * b, one inner product per coefficient, with
+      // the coefficients shared out over the pool.
+      //
+      // Coefficient k costs min(k+1, na, nb, na+nb-1-k) products, so equal
+      // runs of k would be badly unbalanced. Instead the output is cut into
+      // runs of roughly equal cost, several per thread so that a slow
+      // thread doesn't hold up the rest.
+      template <typename T>
+      void parallel_mult(T const *a, std::size_t na, T const *b, std::size_t nb,
+                         T *out, thread_pool &pool)
+      {
+        if (na == 0 || nb == 0)
+          return;
+        std::size_t n = na + nb - 1;
+        auto cost = [&] (std::size_t k) {
+          return std::min(std::min(k + 1, n - k), std::min(na, nb));
+        };
+
+        std::size_t tasks = std::min(n, 8 * pool.size());
+        std::size_t total = na * nb;
+        std::vector<std::size_t> bounds{0};
+        std::size_t done = 0;
+        for (std::size_t k = 0; k < n; ++k)
+        {
+          done += cost(k);
+          if (done * tasks >= total * bounds.size() && bounds.size() < tasks)
+            bounds.push_back(k + 1);
+        }
+        bounds.push_back(n);
+
+        pool.run(bounds.size() - 1, [&] (std::size_t t) {
+            for (std::size_t k = bounds[t]; k < bounds[t + 1]; ++k)
+            {
+              // a[i].b[k-i] for i in [first, last]
+              std::size_t first = k < nb ? 0 : k - nb + 1;
+              std::size_t last = std::min(k, na - 1);
+              out[k] = reversed_dot(a + first, b + (k - last), last - first + 1);
+            }
+          });
+      }
+    } // namespace detail
+  }  // inline namespace v3
+} // namespace ranges
@@ -1,70 +1,1202 @@
 #pragma once
 
+#include "fixed_series.hpp"
+#include "iterate.hpp"
 #include "iterate_n.hpp"
+#include "memo_series.hpp"
 #include "monoidal_zip.hpp"
+#include "newton.hpp"
+#include "parallel_mult.hpp"
+#include "rational_series.hpp"
+#include "relaxed_mult.hpp"
+#include "scan.hpp"
+#include "series_add.hpp"
+#include "series_fill.hpp"
 #include "series_mult.hpp"
 
 #include <range/v3/core.hpp>
 #include <range/v3/numeric/accumulate.hpp>
+#include <range/v3/view/all.hpp>
 #include <range/v3/view/concat.hpp>
 #include <range/v3/view/iota.hpp>
 #include <range/v3/view/single.hpp>
 #include <range/v3/view/tail.hpp>
+#include <range/v3/view/take.hpp>
 #include <range/v3/view/transform.hpp>
 #include <range/v3/view/zip.hpp>
 #include <range/v3/view/zip_with.hpp>
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <memory>
 #include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace power_series
 {
+  namespace detail
+  {
+    struct integrate_coefficient
+    {
+      template <typename X, typename Y>
+      float operator()(X x, Y y) const
+      {
+        return (float)x / (float)y;
+      }
+    };
+
+    template <typename V>
+    using negate_t = decltype(
+        ranges::view::transform(std::declval<V>(), std::negate<>()));
+
+    template <typename V>
+    using differentiate_t = decltype(
+        ranges::view::zip_with(std::multiplies<>(),
+                               ranges::view::iota(1),
+                               ranges::view::tail(std::declval<V>())));
+
+    template <typename V>
+    using integrate_t = decltype(
+        ranges::view::concat(
+            ranges::view::single(0),
+            ranges::view::zip_with(integrate_coefficient{},
+                                   std::declval<V>(),
+                                   ranges::view::iota(1))));
+  }
+
+  // negate, differentiate and integrate return these: each is the view
+  // it's named for, and also keeps the series it was made from, so that
+  // truncate can pass a limit through to it.
+  template <typename V>
+  struct negate_view
+    : detail::negate_t<V>
+  {
+  private:
+    V base_;
+  public:
+    negate_view() = default;
+    explicit negate_view(V v)
+      : detail::negate_t<V>{ranges::view::transform(v, std::negate<>())}
+      , base_{std::move(v)}
+    {}
+    V const& base() const
+    {
+      return base_;
+    }
+    template <typename T>
+    std::size_t fill(T* out, std::size_t n) const
+    {
+      std::size_t k = ranges::series_fill(base_, out, n);
+      for (std::size_t i = 0; i < k; ++i)
+        out[i] = -out[i];
+      return k;
+    }
+  };
+
+  template <typename V>
+  struct differentiate_view
+    : detail::differentiate_t<V>
+  {
+  private:
+    V base_;
+  public:
+    differentiate_view() = default;
+    explicit differentiate_view(V v)
+      : detail::differentiate_t<V>{
+          ranges::view::zip_with(std::multiplies<>(),
+                                 ranges::view::iota(1),
+                                 ranges::view::tail(v))}
+      , base_{std::move(v)}
+    {}
+    V const& base() const
+    {
+      return base_;
+    }
+    // the base in bulk, times the ramp 1, 2, 3, ...
+    template <typename T>
+    std::size_t fill(T* out, std::size_t n) const
+    {
+      std::vector<ranges::range_value_t<V>> b(n + 1);
+      std::size_t k = ranges::series_fill(base_, b.data(), n + 1);
+      k = k > 0 ? k - 1 : 0;
+      for (std::size_t i = 0; i < k; ++i)
+        out[i] = static_cast<int>(i + 1) * b[i + 1];
+      return k;
+    }
+  };
+
+  template <typename V>
+  struct integrate_view
+    : detail::integrate_t<V>
+  {
+  private:
+    V base_;
+  public:
+    integrate_view() = default;
+    explicit integrate_view(V v)
+      : detail::integrate_t<V>{
+          ranges::view::concat(
+              ranges::view::single(0),
+              ranges::view::zip_with(detail::integrate_coefficient{},
+                                     v,
+                                     ranges::view::iota(1)))}
+      , base_{std::move(v)}
+    {}
+    V const& base() const
+    {
+      return base_;
+    }
+    template <typename T>
+    std::size_t fill(T* out, std::size_t n) const
+    {
+      if (n == 0)
+        return 0;
+      std::vector<ranges::range_value_t<V>> b(n - 1);
+      std::size_t k = ranges::series_fill(base_, b.data(), n - 1);
+      out[0] = 0;
+      for (std::size_t i = 0; i < k; ++i)
+        out[i + 1] = detail::integrate_coefficient{}(b[i], static_cast<int>(i + 1));
+      return k + 1;
+    }
+  };
+
+  namespace detail
+  {
+    // Rational series, and cycles, are added, multiplied, negated and
+    // differentiated in closed form, as rational series.
+    struct closed_form_tag {};
+    // fixed_series give fixed_series, at compile time where they can
+    struct fixed_tag {};
+
+    template <typename... Rngs>
+    using closed_form_value_t =
+      ranges::common_type_t<ranges::range_value_t<ranges::uncvref_t<Rngs>>...>;
+
+    template <typename T, typename Rng>
+    inline auto to_rational(Rng const& r)
+    {
+      return ranges::detail::to_rational<T>(r);
+    }
+
+    template <typename Rng>
+    inline auto series_negate(Rng&& r, std::false_type)
+    {
+      using V = ranges::all_t<Rng>;
+      return negate_view<V>{ranges::view::all(std::forward<Rng>(r))};
+    }
+
+    template <typename Rng>
+    inline auto series_negate(Rng&& r, std::true_type)
+    {
+      using T = closed_form_value_t<Rng>;
+      return ranges::detail::rational_negate(detail::to_rational<T>(r));
+    }
+
+    template <typename Rng>
+    constexpr auto series_negate(Rng&& r, fixed_tag)
+    {
+      return detail::fixed_negate(r);
+    }
+
+    template <typename Rng>
+    using unary_tag_t =
+      ranges::meta::if_c<is_fixed_series<ranges::uncvref_t<Rng>>::value,
+                         fixed_tag,
+                         ranges::detail::is_closed_form<ranges::uncvref_t<Rng>>>;
+  }
+
   template <typename Rng>
-  inline auto negate(Rng&& r)
+  constexpr auto negate(Rng&& r)
   {
-    return ranges::view::transform(std::forward<Rng>(r),
-                                   [] (auto i) { return -i; });
+    return detail::series_negate(std::forward<Rng>(r), detail::unary_tag_t<Rng>{});
+  }
+
+  namespace detail
+  {
+    template <typename R1, typename R2>
+    using add_is_contiguous =
+      ranges::detail::series_add_is_contiguous<ranges::all_t<R1>,
+                                               ranges::all_t<R2>>;
+
+    template <typename R1, typename R2>
+    inline auto series_sum(R1&& r1, R2&& r2, std::false_type)
+    {
+      return ranges::view::monoidal_zip(std::plus<>(),
+                                        std::forward<R1>(r1),
+                                        std::forward<R2>(r2));
+    }
+
+    template <typename R1, typename R2>
+    inline auto series_sum(R1&& r1, R2&& r2, std::true_type)
+    {
+      using view_t = ranges::series_add_view<ranges::all_t<R1>,
+                                             ranges::all_t<R2>, std::plus<>>;
+      return view_t{ranges::view::all(std::forward<R1>(r1)),
+                    ranges::view::all(std::forward<R2>(r2))};
+    }
+
+    template <typename R1, typename R2>
+    inline auto series_sum(R1&& r1, R2&& r2, closed_form_tag)
+    {
+      using T = closed_form_value_t<R1, R2>;
+      return ranges::detail::rational_add(detail::to_rational<T>(r1),
+                                          detail::to_rational<T>(r2),
+                                          std::plus<>());
+    }
+
+    template <typename R1, typename R2>
+    constexpr auto series_sum(R1&& r1, R2&& r2, fixed_tag)
+    {
+      return detail::fixed_add(r1, r2, std::plus<>());
+    }
+
+    template <typename R1, typename R2>
+    using add_tag_t =
+      ranges::meta::if_c<are_fixed_series<R1, R2>::value,
+                         fixed_tag,
+                         ranges::meta::if_c<
+                           ranges::detail::are_closed_form<R1, R2>::value,
+                           closed_form_tag,
+                           add_is_contiguous<R1, R2>>>;
   }
 
+  // Contiguous arithmetic series (vectors and arrays) are added in one
+  // pass over their coefficients when the result is first read, and the
+  // result keeps those coefficients: later changes to the inputs aren't
+  // seen (view::monoidal_zip(std::plus<>(), r1, r2) follows them). Other
+  // series are added lazily, one coefficient at a time.
   template <typename R1, typename R2>
-  inline auto add(R1&& r1, R2&& r2)
+  constexpr auto add(R1&& r1, R2&& r2)
+  {
+    return detail::series_sum(std::forward<R1>(r1), std::forward<R2>(r2),
+                              detail::add_tag_t<R1, R2>{});
+  }
+
+  namespace detail
+  {
+    // Where r2 is longer than r1 its remaining coefficients must still be
+    // negated, which monoidal_zip(minus) alone would pass through unchanged.
+    template <typename R1, typename R2>
+    inline auto series_difference(R1&& r1, R2&& r2, std::false_type)
+    {
+      return add(std::forward<R1>(r1), negate(std::forward<R2>(r2)));
+    }
+
+    template <typename R1, typename R2>
+    inline auto series_difference(R1&& r1, R2&& r2, std::true_type)
+    {
+      using view_t = ranges::series_add_view<ranges::all_t<R1>,
+                                             ranges::all_t<R2>, std::minus<>>;
+      return view_t{ranges::view::all(std::forward<R1>(r1)),
+                    ranges::view::all(std::forward<R2>(r2))};
+    }
+
+    template <typename R1, typename R2>
+    inline auto series_difference(R1&& r1, R2&& r2, closed_form_tag)
+    {
+      using T = closed_form_value_t<R1, R2>;
+      return ranges::detail::rational_add(detail::to_rational<T>(r1),
+                                          detail::to_rational<T>(r2),
+                                          std::minus<>());
+    }
+
+    template <typename R1, typename R2>
+    constexpr auto series_difference(R1&& r1, R2&& r2, fixed_tag)
+    {
+      return detail::fixed_add(r1, r2, std::minus<>());
+    }
+
+    template <typename Out, typename R1, typename R2, typename Op>
+    inline std::size_t series_add_into(Out& out, R1& r1, R2& r2, Op op,
+                                       std::false_type)
+    {
+      using T = ranges::range_value_t<Out>;
+      auto o = ranges::begin(out);
+      auto i1 = ranges::begin(r1);
+      auto e1 = ranges::end(r1);
+      auto i2 = ranges::begin(r2);
+      auto e2 = ranges::end(r2);
+      std::size_t n = 0;
+      for (; i1 != e1 && i2 != e2; ++i1, ++i2, ++o, ++n)
+        *o = op(*i1, *i2);
+      for (; i1 != e1; ++i1, ++o, ++n)
+        *o = *i1;
+      for (; i2 != e2; ++i2, ++o, ++n)
+        *o = op(T{}, *i2);
+      return n;
+    }
+
+    template <typename Out, typename R1, typename R2, typename Op>
+    inline std::size_t series_add_into(Out& out, R1& r1, R2& r2, Op op,
+                                       std::true_type)
+    {
+      std::size_t na = ranges::size(r1);
+      std::size_t nb = ranges::size(r2);
+      std::size_t n = std::max(na, nb);
+      RANGES_ASSERT(static_cast<std::size_t>(ranges::size(out)) >= n);
+      if (n > 0)
+        ranges::detail::series_add(ranges::detail::data_of(r1), na,
+                                   ranges::detail::data_of(r2), nb,
+                                   &*ranges::begin(out), op);
+      return n;
+    }
+
+    template <typename Out, typename R1, typename R2>
+    using add_into_is_contiguous =
+      ranges::meta::and_c<add_is_contiguous<R1, R2>::value,
+                          add_is_contiguous<Out, Out>::value,
+                          std::is_same<ranges::range_value_t<Out>,
+                                       ranges::range_value_t<R1>>::value>;
+  }
+
+  // r1 - r2, read as add reads its inputs
+  template <typename R1, typename R2>
+  constexpr auto subtract(R1&& r1, R2&& r2)
+  {
+    return detail::series_difference(std::forward<R1>(r1), std::forward<R2>(r2),
+                                     detail::add_tag_t<R1, R2>{});
+  }
+
+  // out = r1 + r2, written over the first max(size(r1), size(r2)) elements
+  // of out, which must have room for them and may be r1 or r2 itself.
+  // Returns the number of coefficients written.
+  template <typename Out, typename R1, typename R2>
+  inline std::size_t add_into(Out&& out, R1&& r1, R2&& r2)
+  {
+    return detail::series_add_into(out, r1, r2, std::plus<>(),
+                                   detail::add_into_is_contiguous<Out, R1, R2>{});
+  }
+
+  // out = r1 - r2, as add_into
+  template <typename Out, typename R1, typename R2>
+  inline std::size_t subtract_into(Out&& out, R1&& r1, R2&& r2)
+  {
+    return detail::series_add_into(out, r1, r2, std::minus<>(),
+                                   detail::add_into_is_contiguous<Out, R1, R2>{});
+  }
+
+  // The sum of any number of series, advancing them all in one cursor
+  // rather than nesting add.
+  template <typename R1, typename R2, typename... Rs,
+            typename std::enable_if<ranges::Range<R2>(), int>::type = 0>
+  inline auto sum(R1&& r1, R2&& r2, Rs&&... rs)
   {
     return ranges::view::monoidal_zip(std::plus<>(),
                                       std::forward<R1>(r1),
-                                      std::forward<R2>(r2));
+                                      std::forward<R2>(r2),
+                                      std::forward<Rs>(rs)...);
+  }
+
+  // The sum of a range of finite series, as many as there are, accumulated
+  // into one vector.
+  template <typename Rng,
+            typename std::enable_if<
+              ranges::Range<ranges::range_value_t<Rng>>(), int>::type = 0>
+  inline auto sum(Rng&& rs)
+  {
+    using T = ranges::range_value_t<ranges::range_value_t<Rng>>;
+    std::vector<T> v;
+    for (auto&& r : rs)
+    {
+      std::size_t i = 0;
+      for (auto&& x : r)
+      {
+        if (i == v.size())
+          v.push_back(x);
+        else
+          v[i] += x;
+        ++i;
+      }
+    }
+    return v;
+  }
+
+  // The first n coefficients of the sum of a range of series, which may be
+  // infinite; each is read only as far as it needs to be.
+  template <typename Rng,
+            typename std::enable_if<
+              ranges::Range<ranges::range_value_t<Rng>>(), int>::type = 0>
+  inline auto sum(Rng&& rs, std::size_t n)
+  {
+    using T = ranges::range_value_t<ranges::range_value_t<Rng>>;
+    std::vector<T> v(n);
+    for (auto&& r : rs)
+    {
+      auto it = ranges::begin(r);
+      auto last = ranges::end(r);
+      for (std::size_t i = 0; i < n && it != last; ++i, ++it)
+        v[i] += *it;
+    }
+    return v;
+  }
+
+  namespace detail
+  {
+    template <typename R1, typename R2, typename Strategy>
+    inline auto series_product(R1&& r1, R2&& r2, Strategy s, std::false_type)
+    {
+      return ranges::view::series_mult(std::forward<R1>(r1),
+                                       std::forward<R2>(r2),
+                                       s);
+    }
+
+    // rational series multiply numerators and denominators, whatever the
+    // strategy
+    template <typename R1, typename R2, typename Strategy>
+    inline auto series_product(R1&& r1, R2&& r2, Strategy, std::true_type)
+    {
+      using T = closed_form_value_t<R1, R2>;
+      return ranges::detail::rational_multiply(detail::to_rational<T>(r1),
+                                               detail::to_rational<T>(r2));
+    }
+
+    // the full product, by the schoolbook method, which is what the
+    // compiler can run
+    template <typename R1, typename R2, typename Strategy>
+    constexpr auto series_product(R1&& r1, R2&& r2, Strategy, fixed_tag)
+    {
+      return detail::fixed_multiply(r1, r2);
+    }
+
+    template <typename R1, typename R2>
+    using product_tag_t =
+      ranges::meta::if_c<are_fixed_series<R1, R2>::value,
+                         fixed_tag,
+                         ranges::detail::are_closed_form<R1, R2>>;
+  }
+
+  // Sized, random-access series are multiplied in full by the fastest
+  // kernel when the product is first read, and the product keeps those
+  // coefficients: later changes to the inputs aren't seen (the naive
+  // strategy, one inner product per coefficient, follows them). Other
+  // series are multiplied lazily.
+  template <typename R1, typename R2,
+            typename Strategy = ranges::series_mult_strategy::automatic>
+  constexpr auto multiply(R1&& r1, R2&& r2, Strategy s = Strategy{})
+  {
+    return detail::series_product(std::forward<R1>(r1), std::forward<R2>(r2), s,
+                                  detail::product_tag_t<R1, R2>{});
   }
 
+  // Coefficient n is computed having read only n coefficients of each
+  // input, at O(log^2 n) amortized cost, which suits long prefixes of
+  // infinite or single-pass series.
   template <typename R1, typename R2>
-  inline auto subtract(R1&& r1, R2&& r2)
+  inline auto multiply(R1&& r1, R2&& r2, ranges::series_mult_strategy::relaxed)
   {
-    return ranges::view::monoidal_zip(std::minus<>(),
-                                      std::forward<R1>(r1),
+    return ranges::view::relaxed_mult(std::forward<R1>(r1),
                                       std::forward<R2>(r2));
   }
 
+  namespace detail
+  {
+    template <typename Rng>
+    inline auto series_derivative(Rng&& r, std::false_type)
+    {
+      using V = ranges::all_t<Rng>;
+      return differentiate_view<V>{ranges::view::all(std::forward<Rng>(r))};
+    }
+
+    template <typename Rng>
+    inline auto series_derivative(Rng&& r, std::true_type)
+    {
+      using T = closed_form_value_t<Rng>;
+      return ranges::detail::rational_derivative(detail::to_rational<T>(r));
+    }
+
+    template <typename Rng>
+    constexpr auto series_derivative(Rng&& r, fixed_tag)
+    {
+      return detail::fixed_derivative(r);
+    }
+
+    template <typename Rng>
+    inline auto series_integral(Rng&& r, std::false_type)
+    {
+      using V = ranges::all_t<Rng>;
+      return integrate_view<V>{ranges::view::all(std::forward<Rng>(r))};
+    }
+
+    template <typename Rng>
+    constexpr auto series_integral(Rng&& r, std::true_type)
+    {
+      return detail::fixed_integral(r);
+    }
+  }
+
+  template <typename Rng>
+  constexpr auto differentiate(Rng&& r)
+  {
+    return detail::series_derivative(std::forward<Rng>(r),
+                                     detail::unary_tag_t<Rng>{});
+  }
+
+  template <typename Rng>
+  constexpr auto integrate(Rng&& r)
+  {
+    return detail::series_integral(
+        std::forward<Rng>(r),
+        detail::is_fixed_series<ranges::uncvref_t<Rng>>{});
+  }
+
+  namespace detail
+  {
+    template <typename Rng>
+    inline auto truncate(Rng const& r, std::size_t n);
+    template <typename Fun, typename R1, typename R2,
+              typename std::enable_if<std::is_default_constructible<Fun>::value, int>::type = 0>
+    inline auto truncate(ranges::monoidal_zip_view<Fun, R1, R2> const& r, std::size_t n);
+    template <typename Fun, typename... Rngs,
+              typename std::enable_if<std::is_default_constructible<Fun>::value, int>::type = 0>
+    inline auto truncate(ranges::nary_monoidal_zip_view<Fun, Rngs...> const& r, std::size_t n);
+    template <typename R1, typename R2, typename Strategy>
+    inline auto truncate(ranges::series_mult_view<R1, R2, Strategy> const& r, std::size_t n);
+    template <typename R1, typename R2, typename Op>
+    inline auto truncate(ranges::series_add_view<R1, R2, Op> const& r, std::size_t n);
+    template <typename V>
+    inline auto truncate(negate_view<V> const& r, std::size_t n);
+    template <typename V>
+    inline auto truncate(differentiate_view<V> const& r, std::size_t n);
+    template <typename V>
+    inline auto truncate(integrate_view<V> const& r, std::size_t n);
+
+    template <typename Rng>
+    inline auto truncate(Rng const& r, std::size_t n)
+    {
+      return ranges::view::take(
+          r, static_cast<ranges::range_difference_t<Rng const>>(n));
+    }
+
+    template <typename Fun, typename R1, typename R2,
+              typename std::enable_if<std::is_default_constructible<Fun>::value, int>::type>
+    inline auto truncate(ranges::monoidal_zip_view<Fun, R1, R2> const& r, std::size_t n)
+    {
+      return ranges::view::monoidal_zip(Fun{},
+                                        detail::truncate(r.base1(), n),
+                                        detail::truncate(r.base2(), n));
+    }
+
+    template <typename Fun, typename... Rngs, std::size_t... I>
+    inline auto truncate_bases(ranges::nary_monoidal_zip_view<Fun, Rngs...> const& r,
+                               std::size_t n, std::index_sequence<I...>)
+    {
+      return ranges::view::monoidal_zip(
+          Fun{}, detail::truncate(std::get<I>(r.bases()), n)...);
+    }
+
+    template <typename Fun, typename... Rngs,
+              typename std::enable_if<std::is_default_constructible<Fun>::value, int>::type>
+    inline auto truncate(ranges::nary_monoidal_zip_view<Fun, Rngs...> const& r, std::size_t n)
+    {
+      return detail::truncate_bases(r, n, std::index_sequence_for<Rngs...>{});
+    }
+
+    // coefficient k of a product only involves coefficients up to k of
+    // each input, and only the first n of the product are computed
+    template <typename R1, typename R2, typename Strategy>
+    inline auto truncate(ranges::series_mult_view<R1, R2, Strategy> const& r, std::size_t n)
+    {
+      auto a = detail::truncate(r.base1(), n);
+      auto b = detail::truncate(r.base2(), n);
+      using product_t = ranges::series_mult_view<decltype(a), decltype(b), Strategy>;
+      return ranges::view::take(
+          product_t{std::move(a), std::move(b), n},
+          static_cast<ranges::range_difference_t<product_t>>(n));
+    }
+
+    template <typename R1, typename R2, typename Op>
+    inline auto truncate(ranges::series_add_view<R1, R2, Op> const& r, std::size_t n)
+    {
+      // r may already be cut shorter
+      return ranges::series_add_view<R1, R2, Op>{r.base1(), r.base2(),
+                                                 std::min(n, r.size())};
+    }
+
+    template <typename V>
+    inline auto truncate(negate_view<V> const& r, std::size_t n)
+    {
+      return negate(detail::truncate(r.base(), n));
+    }
+
+    template <typename V>
+    inline auto truncate(differentiate_view<V> const& r, std::size_t n)
+    {
+      return differentiate(detail::truncate(r.base(), n + 1));
+    }
+
+    template <typename V>
+    inline auto truncate(integrate_view<V> const& r, std::size_t n)
+    {
+      auto i = integrate(detail::truncate(r.base(), n > 0 ? n - 1 : 0));
+      return ranges::view::take(
+          std::move(i), static_cast<ranges::range_difference_t<decltype(i)>>(n));
+    }
+  }
+
+  // The first n coefficients of a series expression, as view::take(r, n),
+  // but with the limit passed down through the sums (of any arity), products,
+  // derivatives, integrals and negations in r: every input is then read,
+  // and every product kernel run, only as far as those n coefficients
+  // need. Other views are cut off with view::take. The result refers to
+  // containers rather than copying them, so r can't be a temporary one.
+  template <typename Rng>
+  inline auto truncate(Rng&& r, std::size_t n)
+  {
+    static_assert(std::is_lvalue_reference<Rng>::value ||
+                  ranges::View<ranges::uncvref_t<Rng>>(),
+                  "truncate would refer to a destroyed container; pass an lvalue");
+    return detail::truncate(r, n);
+  }
+
+  namespace detail
+  {
+    // A handle to a series that does not keep it alive. Definitions hold
+    // these to refer to themselves, so they don't own themselves.
+    template <typename T>
+    inline ranges::memo_series<T> unowned(ranges::detail::memo_state<T>& s)
+    {
+      return ranges::memo_series<T>{
+        std::shared_ptr<ranges::detail::memo_state<T>>{
+          std::shared_ptr<ranges::detail::memo_state<T>>{}, &s}};
+    }
+
+    template <typename F, typename T, std::size_t N, std::size_t... I>
+    inline auto call_with(F& f, std::array<ranges::memo_series<T>, N>& self,
+                          std::index_sequence<I...>)
+    {
+      return f(self[I]...);
+    }
+
+    template <typename T, typename... F, std::size_t... I>
+    inline std::array<ranges::memo_series<T>, sizeof...(F)> fix(
+        std::index_sequence<I...>, F... f)
+    {
+      using state_t = ranges::detail::memo_deferred<T>;
+      auto group = std::make_shared<std::array<state_t, sizeof...(F)>>();
+      for (auto& s : *group)
+        s.share_mutex((*group)[0]);
+      std::array<ranges::memo_series<T>, sizeof...(F)> self{{
+          unowned<T>((*group)[I])...}};
+      int define[] = {
+        ((*group)[I].define(
+            call_with(f, self, std::make_index_sequence<sizeof...(F)>{})), 0)...};
+      (void)define;
+      return {{ranges::memo_series<T>{
+            std::shared_ptr<ranges::detail::memo_state<T>>{group, &(*group)[I]}}...}};
+    }
+  }
+
+  // A series defined in terms of itself: f is given the series being
+  // defined and returns an expression for it, for example
+  //
+  //   auto e = fix<float>([] (auto e) {
+  //       return add(ranges::view::single(1), integrate(e)); });
+  //
+  // Coefficient n of the expression may only depend on coefficients of the
+  // series below n. Each coefficient is computed once, so the cost is that
+  // of evaluating the expression once.
+  template <typename T, typename F>
+  inline ranges::memo_series<T> fix(F f)
+  {
+    return detail::fix<T>(std::index_sequence<0>{}, std::move(f))[0];
+  }
+
+  // Mutually recursive series: every function is given all of the series
+  // being defined, in order, and returns the expression for its own.
+  //
+  //   auto sc = fix<float>(
+  //       [] (auto sin, auto cos) { return integrate(cos); },
+  //       [] (auto sin, auto cos) {
+  //         return subtract(ranges::view::single(1), integrate(sin)); });
+  template <typename T, typename F1, typename F2, typename... Fs>
+  inline std::array<ranges::memo_series<T>, 2 + sizeof...(Fs)> fix(
+      F1 f1, F2 f2, Fs... fs)
+  {
+    return detail::fix<T>(std::index_sequence_for<F1, F2, Fs...>{},
+                          std::move(f1), std::move(f2), std::move(fs)...);
+  }
+
+  namespace detail
+  {
+    // the first n coefficients of r, padded with zeros if r is shorter
+    template <typename T, typename Rng>
+    inline std::vector<T> coefficients(Rng&& r, std::size_t n)
+    {
+      std::vector<T> v;
+      v.reserve(n);
+      auto it = ranges::begin(r);
+      auto e = ranges::end(r);
+      for (; v.size() < n && it != e; ++it)
+        v.push_back(*it);
+      v.resize(n);
+      return v;
+    }
+  }
+
+  // The product of two finite series, computed eagerly with the output
+  // coefficients shared out over the threads of the pool. Each is an
+  // inner product, so this is quadratic work; it pays where the
+  // coefficients can't go through the subquadratic kernels, or where
+  // cores are more plentiful than the FFT's advantage.
   template <typename R1, typename R2>
-  inline auto multiply(R1&& r1, R2&& r2)
+  inline auto multiply_parallel(R1&& r1, R2&& r2, ranges::thread_pool& pool)
   {
-    return ranges::view::series_mult(std::forward<R1>(r1),
-                                     std::forward<R2>(r2));
+    using T = std::common_type_t<ranges::range_value_t<R1>,
+                                 ranges::range_value_t<R2>>;
+    auto na = static_cast<std::size_t>(ranges::distance(r1));
+    auto nb = static_cast<std::size_t>(ranges::distance(r2));
+    auto a = detail::coefficients<T>(std::forward<R1>(r1), na);
+    auto b = detail::coefficients<T>(std::forward<R2>(r2), nb);
+    std::vector<T> c(na > 0 && nb > 0 ? na + nb - 1 : 0);
+    ranges::detail::parallel_mult(a.data(), na, b.data(), nb, c.data(), pool);
+    return c;
   }
 
+  // The first n coefficients of r1 * r2, as take(multiply(r1, r2), n)
+  // but computing (and reading) no more than that: only n coefficients of
+  // each input are read, and the kernels compute the short product.
+  template <typename R1, typename R2>
+  inline auto multiply_truncated(R1&& r1, R2&& r2, std::size_t n)
+  {
+    using T = std::common_type_t<ranges::range_value_t<R1>,
+                                 ranges::range_value_t<R2>>;
+    auto a = detail::coefficients<T>(std::forward<R1>(r1), n);
+    auto b = detail::coefficients<T>(std::forward<R2>(r2), n);
+    return detail::mul(a, b, n);
+  }
+
+  // Coefficients [lo, hi) of r1 * r2: the middle product. Newton iteration
+  // wants the upper half of a product whose lower half it already knows,
+  // and the transforms for that are half the size of the full product's.
+  template <typename R1, typename R2>
+  inline auto multiply_middle(R1&& r1, R2&& r2, std::size_t lo, std::size_t hi)
+  {
+    using T = std::common_type_t<ranges::range_value_t<R1>,
+                                 ranges::range_value_t<R2>>;
+    auto a = detail::coefficients<T>(std::forward<R1>(r1), hi);
+    auto b = detail::coefficients<T>(std::forward<R2>(r2), hi);
+    return detail::mul_middle(a, b, lo, hi);
+  }
+
+  // The first n coefficients of 1/r by Newton iteration, in a constant
+  // number of multiplications of length n. The constant coefficient of r
+  // must be invertible (1 or -1 for integers).
   template <typename Rng>
-  inline auto differentiate(Rng&& r)
+  inline std::vector<ranges::range_value_t<Rng>> reciprocal(Rng&& r, std::size_t n)
   {
-    return ranges::view::zip_with(std::multiplies<>(),
-                                  ranges::view::iota(1),
-                                  ranges::view::tail(std::forward<Rng>(r)));
+    using T = ranges::range_value_t<Rng>;
+    return detail::reciprocal(detail::coefficients<T>(std::forward<Rng>(r), n), n);
   }
 
+  // the first n coefficients of r1/r2
+  template <typename R1, typename R2>
+  inline auto divide(R1&& r1, R2&& r2, std::size_t n)
+  {
+    using T = std::common_type_t<ranges::range_value_t<R1>,
+                                 ranges::range_value_t<R2>>;
+    return detail::divide(detail::coefficients<T>(std::forward<R1>(r1), n),
+                          detail::coefficients<T>(std::forward<R2>(r2), n), n);
+  }
+
+  // 1/r as a lazy series, for when the number of terms isn't known up
+  // front. Writing r = r0 + x.t, the reciprocal g satisfies
+  // g = (1 - x.t.g) / r0, and the relaxed product makes that cost
+  // O(n log^2 n) for n coefficients.
   template <typename Rng>
-  inline auto integrate(Rng&& r)
+  inline auto reciprocal(Rng&& r)
+  {
+    using T = ranges::range_value_t<Rng>;
+    auto f = ranges::view::memoize(std::forward<Rng>(r));
+    RANGES_ASSERT(detail::is_unit(ranges::at(f, 0)));
+    T f0_inv = T{1} / ranges::at(f, 0);
+    return fix<T>([f, f0_inv] (auto g) {
+        return ranges::view::transform(
+            subtract(ranges::view::single(T{1}),
+                     ranges::view::concat(
+                         ranges::view::single(T{}),
+                         multiply(ranges::view::tail(f), g,
+                                  ranges::series_mult_strategy::relaxed{}))),
+            [f0_inv] (T x) { return x * f0_inv; });
+      });
+  }
+
+  // r1/r2 as a lazy series: as for reciprocal, with r1 in place of 1
+  template <typename R1, typename R2>
+  inline auto divide(R1&& r1, R2&& r2)
   {
-    return ranges::view::concat(
-        ranges::view::single(0),
-        ranges::view::zip_with([] (auto x, auto y) { return (float)x / (float)y; },
-                               std::forward<Rng>(r),
-                               ranges::view::iota(1)));
+    using T = std::common_type_t<ranges::range_value_t<R1>,
+                                 ranges::range_value_t<R2>>;
+    auto a = ranges::view::all(std::forward<R1>(r1));
+    auto f = ranges::view::memoize(std::forward<R2>(r2));
+    RANGES_ASSERT(detail::is_unit(ranges::at(f, 0)));
+    T f0_inv = T{1} / ranges::at(f, 0);
+    return fix<T>([a, f, f0_inv] (auto h) {
+        return ranges::view::transform(
+            subtract(a,
+                     ranges::view::concat(
+                         ranges::view::single(T{}),
+                         multiply(ranges::view::tail(f), h,
+                                  ranges::series_mult_strategy::relaxed{}))),
+            [f0_inv] (T x) { return x * f0_inv; });
+      });
+  }
+
+  namespace detail
+  {
+    // exp, log and friends divide by integers, so integer series give
+    // float results as integrate does
+    template <typename Rng>
+    using fractional_t = std::common_type_t<ranges::range_value_t<Rng>, float>;
+
+    template <typename E>
+    constexpr bool is_negative(E e, std::true_type)
+    {
+      return e < 0;
+    }
+
+    template <typename E>
+    constexpr bool is_negative(E, std::false_type)
+    {
+      return false;
+    }
+
+    // a negative integer power is a positive power of 1/f
+    template <typename T, typename E>
+    inline std::vector<T> pow(std::vector<T> const& f, E e, std::size_t n,
+                              std::true_type)
+    {
+      if (!detail::is_negative(e, std::is_signed<E>{}))
+        return detail::pow(f, static_cast<std::uint64_t>(e), n);
+      if (n == 0)
+        return {};
+      return detail::pow(detail::reciprocal(f, n),
+                         std::uint64_t{0} - static_cast<std::uint64_t>(e), n);
+    }
+
+    template <typename T, typename E>
+    inline std::vector<T> pow(std::vector<T> const& f, E e, std::size_t n,
+                              std::false_type)
+    {
+      return detail::pow(f, static_cast<T>(e), n);
+    }
+  }
+
+  // The first n coefficients of exp(r), of log(r), of r^e and of sqrt(r),
+  // each by Newton iteration in a constant number of multiplications of
+  // length n (against O(n^2) for the usual recurrences). exp needs a
+  // constant coefficient of 0, and log one of 1.
+  template <typename Rng>
+  inline std::vector<detail::fractional_t<Rng>> exp(Rng&& r, std::size_t n)
+  {
+    using T = detail::fractional_t<Rng>;
+    return detail::exp(detail::coefficients<T>(std::forward<Rng>(r), n), n);
+  }
+
+  template <typename Rng>
+  inline std::vector<detail::fractional_t<Rng>> log(Rng&& r, std::size_t n)
+  {
+    using T = detail::fractional_t<Rng>;
+    return detail::log(detail::coefficients<T>(std::forward<Rng>(r), n), n);
+  }
+
+  // A non-negative integer e allows any r, including ones with leading
+  // zeros; a negative one needs the constant coefficient of r invertible.
+  // Otherwise the coefficients must be floating point and the constant
+  // coefficient of r positive.
+  template <typename Rng, typename E>
+  inline std::vector<detail::fractional_t<Rng>> pow(Rng&& r, E e, std::size_t n)
+  {
+    using T = detail::fractional_t<Rng>;
+    return detail::pow(detail::coefficients<T>(std::forward<Rng>(r), n), e, n,
+                       std::is_integral<E>{});
+  }
+
+  template <typename Rng>
+  inline std::vector<detail::fractional_t<Rng>> sqrt(Rng&& r, std::size_t n)
+  {
+    using T = detail::fractional_t<Rng>;
+    return detail::sqrt(detail::coefficients<T>(std::forward<Rng>(r), n), n);
+  }
+
+  // The first n coefficients of r1(r2(x)). The constant coefficient of r2
+  // must be 0, so that only n coefficients of r1 matter.
+  template <typename R1, typename R2>
+  inline auto compose(R1&& r1, R2&& r2, std::size_t n)
+  {
+    using T = std::common_type_t<ranges::range_value_t<R1>,
+                                 ranges::range_value_t<R2>>;
+    return detail::compose(detail::coefficients<T>(std::forward<R1>(r1), n),
+                           detail::coefficients<T>(std::forward<R2>(r2), n), n);
+  }
+
+  // The first n coefficients of the series g with r(g(x)) = x. r must
+  // start 0 + cx with c invertible.
+  template <typename Rng>
+  inline std::vector<ranges::range_value_t<Rng>> revert(Rng&& r, std::size_t n)
+  {
+    using T = ranges::range_value_t<Rng>;
+    return detail::revert(detail::coefficients<T>(std::forward<Rng>(r), n), n);
+  }
+
+  namespace detail
+  {
+    // from this many coefficients, evaluate uses Estrin's scheme
+    constexpr std::size_t estrin_threshold = 32;
+  }
+
+  // The value of the finite series r at x: by Horner's rule, or for long
+  // series by Estrin's scheme, whose dependency chain is log n long
+  // rather than n.
+  template <typename Rng, typename X>
+  inline auto evaluate(Rng&& r, X x)
+  {
+    using T = std::common_type_t<ranges::range_value_t<Rng>, X>;
+    auto n = static_cast<std::size_t>(ranges::distance(r));
+    auto c = detail::coefficients<T>(std::forward<Rng>(r), n);
+    T t = x;
+    if (n >= detail::estrin_threshold)
+      return ranges::detail::estrin(c.data(), n, t);
+    T y;
+    ranges::detail::horner_many(c.data(), n, &t, 1, &y);
+    return y;
+  }
+
+  // The values of the finite series r at each of the points xs, written
+  // to out; returns the end of the output. The coefficients are read
+  // once, and Horner's rule runs on a vector's worth of points at a time.
+  // For exact coefficients (modular integers) with thousands of points
+  // and terms, the points go through a subproduct tree instead, in
+  // O(M(n) log n).
+  template <typename Rng, typename Xs, typename O>
+  inline O evaluate_many(Rng&& r, Xs&& xs, O out)
+  {
+    using T = std::common_type_t<ranges::range_value_t<Rng>,
+                                 ranges::range_value_t<Xs>>;
+    auto n = static_cast<std::size_t>(ranges::distance(r));
+    auto m = static_cast<std::size_t>(ranges::distance(xs));
+    auto c = detail::coefficients<T>(std::forward<Rng>(r), n);
+    auto x = detail::coefficients<T>(std::forward<Xs>(xs), m);
+    std::vector<T> y(m);
+    detail::evaluate_many(c, x.data(), m, y.data(), std::is_floating_point<T>{});
+    return std::copy(y.begin(), y.end(), out);
+  }
+
+  namespace summation
+  {
+    // partial sums, until a geometric estimate of the tail is within tol
+    struct direct {};
+    // Aitken's delta-squared extrapolation of the partial sums, for
+    // series whose error shrinks geometrically
+    struct aitken {};
+    // Euler's transform, by repeated averaging of the partial sums, for
+    // alternating series
+    struct euler {};
+  }
+
+  template <typename T>
+  struct sum_result
+  {
+    T value;
+    // the coefficients of the series read
+    std::size_t terms;
+    // false if max_terms ran out first
+    bool converged;
+  };
+
+  namespace detail
+  {
+    template <typename T>
+    inline double magnitude(T const& x)
+    {
+      using std::abs;
+      return static_cast<double>(abs(x));
+    }
+
+    // Each method takes the partial sums one at a time; step says whether
+    // its estimate of the sum is now within tol.
+    template <typename T, typename Method>
+    struct summer;
+
+    // A heuristic, not a bound: the terms beyond the last non-zero one t
+    // are taken to shrink geometrically, by the largest ratio between the
+    // last few non-zero terms, which puts the tail at t.r/(1 - r). Zero
+    // terms leave that estimate as it was (so series with gaps, like sin,
+    // still converge), and a long enough run of them is taken to be the
+    // end of the series.
+    template <typename T>
+    struct summer<T, summation::direct>
+    {
+      static constexpr std::size_t window = 4;
+      static constexpr std::size_t zero_run = 16;
+      T last{};
+      // the magnitudes of the last non-zero terms, newest last
+      std::array<double, window> nonzero{};
+      std::size_t seen = 0;
+      std::size_t zeros = 0;
+
+      bool step(T const& s, double tol)
+      {
+        double t = magnitude(s - last);
+        last = s;
+        if (t == 0)
+          return ++zeros >= zero_run;
+        zeros = 0;
+        std::rotate(nonzero.begin(), nonzero.begin() + 1, nonzero.end());
+        nonzero.back() = t;
+        if (++seen < 3 || t > tol)
+          return false;
+        double ratio = 0;
+        for (std::size_t i = window - std::min(seen, std::size_t{window}) + 1;
+             i < window; ++i)
+          ratio = std::max(ratio, nonzero[i] / nonzero[i - 1]);
+        return ratio < 1 && t * ratio <= tol * (1 - ratio);
+      }
+      T estimate() const
+      {
+        return last;
+      }
+    };
+
+    // extrapolated estimates that agree within tol twice running
+    template <typename T>
+    struct agreement
+    {
+      T last{};
+      std::size_t agreed = 0;
+      bool started = false;
+
+      bool next(T const& e, double tol)
+      {
+        agreed = started && magnitude(e - last) <= tol ? agreed + 1 : 0;
+        started = true;
+        last = e;
+        return agreed >= 2;
+      }
+    };
+
+    template <typename T>
+    struct summer<T, summation::aitken>
+    {
+      std::array<T, 3> sums{};
+      std::size_t n = 0;
+      agreement<T> estimates;
+
+      bool step(T const& s, double tol)
+      {
+        sums[0] = sums[1];
+        sums[1] = sums[2];
+        sums[2] = s;
+        if (++n < 3)
+          return estimates.next(s, tol);
+        T d1 = sums[2] - sums[1];
+        T d2 = d1 - (sums[1] - sums[0]);
+        return estimates.next(d2 == T{} ? s : s - d1 * d1 / d2, tol);
+      }
+      T estimate() const
+      {
+        return estimates.last;
+      }
+    };
+
+    // diagonal holds the newest entry of each order of averaging
+    template <typename T>
+    struct summer<T, summation::euler>
+    {
+      std::vector<T> diagonal;
+      agreement<T> estimates;
+
+      bool step(T const& s, double tol)
+      {
+        T a = s;
+        for (auto& x : diagonal)
+        {
+          T b = (a + x) / T{2};
+          x = a;
+          a = b;
+        }
+        diagonal.push_back(a);
+        return estimates.next(a, tol);
+      }
+      T estimate() const
+      {
+        return estimates.last;
+      }
+    };
+  }
+
+  // The sum of the series r at x, read only as far as it takes to be
+  // within tol: the coefficients stream through view::scan of their terms,
+  // and the chosen summation method says when to stop. The result reports
+  // how many coefficients that took, and whether it got there within
+  // max_terms. A finite series is summed exactly.
+  template <typename Rng, typename X, typename Method = summation::direct>
+  inline auto sum_at(Rng&& r, X x, double tol, Method = Method{},
+                     std::size_t max_terms = std::size_t{1} << 20)
+  {
+    using T = std::common_type_t<ranges::range_value_t<Rng>, X>;
+    auto powers = ranges::view::iterate([x] (T p) { return p * x; }, T{1});
+    auto sums = ranges::view::scan(
+        ranges::view::zip_with([] (T c, T p) { return c * p; },
+                               std::forward<Rng>(r), std::move(powers)),
+        T{});
+    detail::summer<T, Method> summer;
+    sum_result<T> result{T{}, 0, false};
+    auto it = ranges::begin(sums);
+    auto e = ranges::end(sums);
+    for (++it; it != e; ++it)
+    {
+      if (result.terms == max_terms)
+      {
+        result.value = summer.estimate();
+        return result;
+      }
+      ++result.terms;
+      result.value = *it;
+      // every term past the constant one is zero
+      if (x == X{})
+      {
+        result.converged = true;
+        return result;
+      }
+      if (summer.step(result.value, tol))
+      {
+        result.value = summer.estimate();
+        result.converged = true;
+        return result;
+      }
+    }
+    // all of a finite series
+    result.converged = true;
+    return result;
+  }
+
+  // The shortest linear recurrence with constant coefficients, of order
+  // at most max_order, that the first 2 max_order coefficients of r
+  // satisfy, found by Berlekamp-Massey, as the rational_series it
+  // generates. Only that prefix is read; from then on the result streams
+  // each coefficient in O(order) and jumps to any one in logarithmic time.
+  // The coefficients must be a field: modular integers, or floating point,
+  // where discrepancies within tol count as zero. If the prefix fits no
+  // recurrence that short, the series returned only reproduces the prefix,
+  // and its order() is more than max_order.
+  template <typename Rng>
+  inline ranges::rational_series<ranges::range_value_t<Rng>> find_recurrence(
+      Rng&& r, std::size_t max_order,
+      ranges::range_value_t<Rng> tol = ranges::range_value_t<Rng>{})
+  {
+    using T = ranges::range_value_t<Rng>;
+    auto s = detail::coefficients<T>(std::forward<Rng>(r), 2 * max_order);
+    auto q = ranges::detail::berlekamp_massey(s, tol);
+    // Q.s = P below x^order
+    auto p = q.size() > 1 ? detail::mul(s, q, q.size() - 1) : std::vector<T>{};
+    return {std::move(p), std::move(q)};
   }
 
   namespace detail
@@ -105,12 +1237,46 @@ namespace power_series
     }
   }
 
+  // The first n coefficients of r, or all of them if r is shorter, written
+  // by the view's bulk fill where it has one.
+  template <typename Rng>
+  inline std::vector<ranges::range_value_t<Rng>> to_vector(Rng&& r, std::size_t n)
+  {
+    std::vector<ranges::range_value_t<Rng>> v(n);
+    v.resize(ranges::series_fill(r, v.data(), n));
+    return v;
+  }
+
+  // all the coefficients of a finite series
+  template <typename Rng>
+  inline std::vector<ranges::range_value_t<Rng>> to_vector(Rng&& r)
+  {
+    return to_vector(r, static_cast<std::size_t>(ranges::distance(r)));
+  }
+
+  namespace detail
+  {
+    // sized views with a bulk fill are materialized first
+    template <typename Rng, typename T = ranges::range_value_t<Rng>>
+    inline auto to_string_of(Rng& r, int)
+      -> decltype(r.fill(std::declval<T*>(), std::size_t{}), ranges::size(r),
+                  std::string())
+    {
+      auto v = to_vector(r, static_cast<std::size_t>(ranges::size(r)));
+      return detail::to_string(ranges::view::zip(v, ranges::view::iota(0)));
+    }
+
+    template <typename Rng>
+    inline std::string to_string_of(Rng& r, long)
+    {
+      return detail::to_string(ranges::view::zip(r, ranges::view::iota(0)));
+    }
+  }
+
   template <typename Rng>
   inline std::string to_string(Rng&& r)
   {
-    return detail::to_string(
-        ranges::view::zip(std::forward<Rng>(r),
-                          ranges::view::iota(0)));
+    return detail::to_string_of(r, 0);
   }
 
   template <typename Rng>
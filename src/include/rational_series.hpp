@@ -0,0 +1,397 @@
+#pragma once
+
+#include "cycle.hpp"
+#include "series_mult.hpp"
+
+#include <range/v3/core.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ranges
+{
+  inline namespace v3
+  {
+    namespace detail
+    {
+      // products of coefficient vectors, by the fastest series_mult kernel
+      template <typename T>
+      std::vector<T> polynomial_mult(std::vector<T> const &a, std::vector<T> const &b)
+      {
+        if (a.empty() || b.empty())
+          return {};
+        std::vector<T> out(a.size() + b.size() - 1);
+        series_mult_product(a.data(), a.size(), b.data(), b.size(), out.data(),
+                            series_mult_strategy::automatic{});
+        return out;
+      }
+
+      template <typename T, typename Op>
+      std::vector<T> polynomial_add(std::vector<T> const &a, std::vector<T> const &b,
+                                    Op op)
+      {
+        std::vector<T> out(std::max(a.size(), b.size()));
+        for (std::size_t i = 0; i < out.size(); ++i)
+          out[i] = op(i < a.size() ? a[i] : T{}, i < b.size() ? b[i] : T{});
+        return out;
+      }
+
+      template <typename T>
+      std::vector<T> polynomial_derivative(std::vector<T> const &a)
+      {
+        std::vector<T> out(a.empty() ? 0 : a.size() - 1);
+        for (std::size_t i = 0; i < out.size(); ++i)
+          out[i] = a[i + 1] * T(static_cast<std::int64_t>(i + 1));
+        return out;
+      }
+    } // namespace detail
+
+    // The power series P(x)/Q(x), which is what any series satisfying a
+    // linear recurrence with constant coefficients is: view::cycle of a
+    // finite range, for one, is its period over 1 - x^period. Q(0) must be
+    // invertible in T (1 or -1 for integers).
+    //
+    // Coefficients stream by the recurrence Q.c = P in O(deg Q) each;
+    // coefficient(n) finds any one of them in O(M(deg Q) log n) by
+    // Bostan-Mori, and cursors jump with it. For integers, Bostan-Mori works
+    // modulo 2^bits, so a coefficient too large for T comes back wrapped;
+    // those the recurrence reaches without overflow come back exact.
+    // Sums, products, negation and derivatives of rational series (see
+    // power_series.hpp) are rational series again, computed on P and Q.
+    template<typename T>
+    struct rational_series
+      : view_facade<rational_series<T>, infinite>
+    {
+    private:
+      friend struct range_access;
+      std::vector<T> p_;
+      std::vector<T> q_;
+
+      struct cursor
+      {
+        using difference_type = std::ptrdiff_t;
+      private:
+        rational_series const *rng_;
+        // the last deg Q coefficients, c_m in slot m mod deg Q, where those
+        // before the start are zero
+        std::vector<T> window_;
+        T value_;
+        difference_type n_;
+
+        T &slot(difference_type m)
+        {
+          auto d = static_cast<difference_type>(window_.size());
+          return window_[static_cast<std::size_t>((m % d + d) % d)];
+        }
+        // c_n = (p_n - q_1.c_{n-1} - ... - q_d.c_{n-d}) / q_0
+        void compute()
+        {
+          auto &p = rng_->p_;
+          auto &q = rng_->q_;
+          T s = static_cast<std::size_t>(n_) < p.size() ?
+            p[static_cast<std::size_t>(n_)] : T{};
+          for (std::size_t i = 1; i < q.size(); ++i)
+            s = s - q[i] * slot(n_ - static_cast<difference_type>(i));
+          value_ = s / q[0];
+          if (!window_.empty())
+            slot(n_) = value_;
+        }
+      public:
+        cursor() = default;
+        cursor(rational_series const &rng)
+          : rng_(&rng)
+          , window_(rng.q_.size() - 1, T{})
+          , value_{}
+          , n_(0)
+        {
+          compute();
+        }
+        constexpr bool done() const
+        {
+          return false;
+        }
+        T current() const
+        {
+          return value_;
+        }
+        void next()
+        {
+          ++n_;
+          compute();
+        }
+        void prev()
+        {
+          advance(-1);
+        }
+        // short steps forward follow the recurrence; otherwise the window
+        // is refilled from coefficient(m)
+        void advance(difference_type k)
+        {
+          if (k >= 0 && k <= 64)
+          {
+            for (; k > 0; --k)
+              next();
+            return;
+          }
+          n_ += k;
+          auto d = static_cast<difference_type>(window_.size());
+          for (difference_type m = n_ - d; m < n_; ++m)
+            slot(m) = m < 0 ? T{} : rng_->coefficient(static_cast<std::uint64_t>(m));
+          compute();
+        }
+        bool equal(cursor const &that) const
+        {
+          return n_ == that.n_;
+        }
+        difference_type distance_to(cursor const &that) const
+        {
+          return that.n_ - n_;
+        }
+      };
+
+      cursor begin_cursor() const
+      {
+        return {*this};
+      }
+
+    public:
+      rational_series()
+        : q_{T{1}}
+      {}
+      rational_series(std::vector<T> p, std::vector<T> q)
+        : p_(std::move(p))
+        , q_(std::move(q))
+      {
+        RANGES_ASSERT(!q_.empty() && q_[0] != T{});
+      }
+      // one period over 1 - x^period
+      template<typename Rng>
+      rational_series(cycle_view<Rng> const &c)
+        : q_{T{1}}
+      {
+        for (auto &&x : c.base())
+          p_.push_back(static_cast<T>(x));
+        RANGES_ASSERT(!p_.empty());
+        q_.resize(p_.size() + 1, T{});
+        q_.back() = -T{1};
+      }
+
+      std::vector<T> const &numerator() const
+      {
+        return p_;
+      }
+      std::vector<T> const &denominator() const
+      {
+        return q_;
+      }
+      // the length of the recurrence: each coefficient past the numerator
+      // depends on this many before it
+      std::size_t order() const
+      {
+        return q_.size() - 1;
+      }
+      // the recurrence run over the output itself
+      std::size_t fill(T *out, std::size_t n) const
+      {
+        for (std::size_t k = 0; k < n; ++k)
+        {
+          T s = k < p_.size() ? p_[k] : T{};
+          for (std::size_t i = 1; i < q_.size() && i <= k; ++i)
+            s = s - q_[i] * out[k - i];
+          out[k] = s / q_[0];
+        }
+        return n;
+      }
+
+      // [x^n] P/Q, which must fit in T
+      T coefficient(std::uint64_t n) const
+      {
+        return coefficient(n, std::is_integral<T>{});
+      }
+
+    private:
+      // Bostan-Mori: [x^n] P/Q = [x^(n/2)] U_(n mod 2)/V, where P(x).Q(-x) =
+      // U_0(x^2) + x.U_1(x^2) and Q(x).Q(-x) = V(x^2). Halves n until it is
+      // zero, leaving the answer as p[0]/q[0].
+      template<typename U>
+      static void bostan_mori(std::vector<U> &p, std::vector<U> &q, std::uint64_t n)
+      {
+        for (; n > 0 && !p.empty(); n >>= 1)
+        {
+          std::vector<U> q_minus = q;
+          for (std::size_t i = 1; i < q_minus.size(); i += 2)
+            q_minus[i] = -q_minus[i];
+          auto u = detail::polynomial_mult(p, q_minus);
+          auto v = detail::polynomial_mult(q, q_minus);
+          p.clear();
+          for (std::size_t i = n & 1; i < u.size(); i += 2)
+            p.push_back(u[i]);
+          q.clear();
+          for (std::size_t i = 0; i < v.size(); i += 2)
+            q.push_back(v[i]);
+        }
+      }
+
+      T coefficient(std::uint64_t n, std::false_type) const
+      {
+        std::vector<T> p = p_;
+        std::vector<T> q = q_;
+        bostan_mori(p, q, n);
+        return p.empty() ? T{} : p[0] / q[0];
+      }
+
+      // Q squares at every step, so integer coefficients would overflow long
+      // before the answer does. The doubling runs modulo 2^bits in unsigned
+      // arithmetic instead: Q(0) = 1 or -1 is a unit there, so the result is
+      // right whenever it fits in T.
+      T coefficient(std::uint64_t n, std::true_type) const
+      {
+        using U = typename std::common_type<
+          typename std::make_unsigned<T>::type, unsigned>::type;
+        std::vector<U> p(p_.size());
+        std::vector<U> q(q_.size());
+        std::transform(p_.begin(), p_.end(), p.begin(),
+                       [] (T x) { return static_cast<U>(x); });
+        std::transform(q_.begin(), q_.end(), q.begin(),
+                       [] (T x) { return static_cast<U>(x); });
+        bostan_mori(p, q, n);
+        // q[0] is its own inverse
+        return p.empty() ? T{} : static_cast<T>(p[0] * q[0]);
+      }
+    };
+
+    namespace detail
+    {
+      // series that have a rational_series form
+      template<typename Rng>
+      struct is_closed_form
+        : std::false_type
+      {};
+      template<typename T>
+      struct is_closed_form<rational_series<T>>
+        : std::true_type
+      {};
+      template<typename Rng>
+      struct is_closed_form<cycle_view<Rng>>
+        : std::true_type
+      {};
+
+      template<typename R1, typename R2>
+      using are_closed_form =
+        meta::and_c<is_closed_form<uncvref_t<R1>>::value,
+                    is_closed_form<uncvref_t<R2>>::value>;
+
+      template<typename T, typename U>
+      rational_series<T> to_rational(rational_series<U> const &r)
+      {
+        return {std::vector<T>(r.numerator().begin(), r.numerator().end()),
+                std::vector<T>(r.denominator().begin(), r.denominator().end())};
+      }
+
+      template<typename T, typename Rng>
+      rational_series<T> to_rational(cycle_view<Rng> const &r)
+      {
+        return r;
+      }
+
+      template<typename T, typename Op>
+      rational_series<T> rational_add(rational_series<T> const &a,
+                                      rational_series<T> const &b, Op op)
+      {
+        // sums of cycles of the same period keep their denominator
+        if (a.denominator() == b.denominator())
+          return {polynomial_add(a.numerator(), b.numerator(), op),
+                  a.denominator()};
+        return {polynomial_add(polynomial_mult(a.numerator(), b.denominator()),
+                               polynomial_mult(b.numerator(), a.denominator()),
+                               op),
+                polynomial_mult(a.denominator(), b.denominator())};
+      }
+
+      template<typename T>
+      rational_series<T> rational_multiply(rational_series<T> const &a,
+                                           rational_series<T> const &b)
+      {
+        return {polynomial_mult(a.numerator(), b.numerator()),
+                polynomial_mult(a.denominator(), b.denominator())};
+      }
+
+      template<typename T>
+      rational_series<T> rational_negate(rational_series<T> const &a)
+      {
+        std::vector<T> p = a.numerator();
+        for (auto &x : p)
+          x = -x;
+        return {std::move(p), a.denominator()};
+      }
+
+      // whether a discrepancy counts as zero: exactly, except for floating
+      // point, where it's within tol
+      template<typename T>
+      bool negligible(T const &x, T const &, std::false_type)
+      {
+        return x == T{};
+      }
+
+      template<typename T>
+      bool negligible(T const &x, T const &tol, std::true_type)
+      {
+        return std::abs(x) <= tol;
+      }
+
+      // Berlekamp-Massey: the shortest Q, with Q(0) = 1, such that Q.s is a
+      // polynomial of degree below deg Q up to x^size(s). T must be a field.
+      // The returned Q has one more coefficient than the recurrence's
+      // order, the last possibly zero.
+      template<typename T>
+      std::vector<T> berlekamp_massey(std::vector<T> const &s, T const &tol)
+      {
+        using floating_t = std::is_floating_point<T>;
+        std::vector<T> c{T{1}};
+        std::vector<T> b{T{1}};
+        T last = T{1};
+        std::size_t order = 0;
+        std::size_t shift = 1;
+        for (std::size_t n = 0; n < s.size(); ++n, ++shift)
+        {
+          T d = s[n];
+          for (std::size_t i = 1; i <= order && i < c.size(); ++i)
+            d = d + c[i] * s[n - i];
+          if (negligible(d, tol, floating_t{}))
+            continue;
+          T k = d / last;
+          std::vector<T> previous = c;
+          c.resize(std::max(c.size(), b.size() + shift), T{});
+          for (std::size_t i = 0; i < b.size(); ++i)
+            c[i + shift] = c[i + shift] - k * b[i];
+          if (2 * order <= n)
+          {
+            order = n + 1 - order;
+            b = std::move(previous);
+            last = d;
+            shift = 0;
+          }
+        }
+        c.resize(order + 1, T{});
+        return c;
+      }
+
+      // (P/Q)' = (P'.Q - P.Q') / Q^2
+      template<typename T>
+      rational_series<T> rational_derivative(rational_series<T> const &a)
+      {
+        auto &p = a.numerator();
+        auto &q = a.denominator();
+        return {polynomial_add(polynomial_mult(polynomial_derivative(p), q),
+                               polynomial_mult(p, polynomial_derivative(q)),
+                               [] (T const &x, T const &y) { return x - y; }),
+                polynomial_mult(q, q)};
+      }
+    } // namespace detail
+  }  // inline namespace v3
+} // namespace ranges
@@ -0,0 +1,264 @@
+#pragma once
+
+#include "series_mult.hpp"
+
+#include <range/v3/core.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace ranges
+{
+  inline namespace v3
+  {
+    namespace series_mult_strategy
+    {
+      // online product for lazy inputs, see relaxed_mult_view
+      struct relaxed {};
+    }
+
+    namespace detail
+    {
+      // Online product of two series: coefficient n of the result is
+      // available as soon as coefficient n of each input has been pushed.
+      //
+      // The (i, j) quadrant of partial products a_i.b_j is tiled with
+      // squares of side p = 2^k: rows [p-1, 2p-1) against columns
+      // [mp-1, (m+1)p-1) for m >= 1, and the transposed squares for m >= 2.
+      // The lowest output a square touches is (m+1)p - 2, and that is also
+      // the last input it needs, so each square is multiplied (by the fast
+      // kernels) the moment it is complete. About n/p squares of side p
+      // are needed for every p, which makes n coefficients cost
+      // O(n log^2 n) with FFT-sized squares.
+      template <typename T>
+      struct relaxed_product
+      {
+      private:
+        std::vector<T> a_;
+        std::vector<T> b_;
+        std::vector<T> c_;
+        std::vector<T> square_;
+
+        void add_square(T const *x, T const *y, std::size_t p, std::size_t at)
+        {
+          if (c_.size() < at + 2*p - 1)
+            c_.resize(at + 2*p - 1);
+          if (p == 1)
+          {
+            c_[at] += x[0] * y[0];
+            return;
+          }
+          square_.resize(2*p - 1);
+          series_mult_product(x, p, y, p, square_.data(),
+                              series_mult_strategy::automatic{});
+          for (std::size_t i = 0; i < 2*p - 1; ++i)
+            c_[at + i] += square_[i];
+        }
+
+      public:
+        std::size_t size() const
+        {
+          return a_.size();
+        }
+        T const &operator[](std::size_t n) const
+        {
+          return c_[n];
+        }
+        // feed the next coefficient of each input; returns the next
+        // coefficient of the product
+        T const &push(T an, T bn)
+        {
+          std::size_t n = a_.size();
+          a_.push_back(std::move(an));
+          b_.push_back(std::move(bn));
+          for (std::size_t p = 1; 2*p <= n + 2; p *= 2)
+          {
+            if ((n + 2) % p != 0)
+              continue;
+            std::size_t m = (n + 2) / p - 1;
+            add_square(&a_[p - 1], &b_[m*p - 1], p, n);
+            if (m >= 2)
+              add_square(&b_[p - 1], &a_[m*p - 1], p, n);
+          }
+          return c_[n];
+        }
+      };
+    } // namespace detail
+
+    template<typename R1, typename R2>
+    struct relaxed_mult_view
+      : view_facade<relaxed_mult_view<R1, R2>,
+                    detail::series_mult_cardinality<
+                      range_cardinality<R1>,
+                      range_cardinality<R2>>::value>
+    {
+    private:
+      friend range_access;
+      using difference_type_ = common_type_t<range_difference_t<R1>,
+                                             range_difference_t<R2>>;
+      using value_type_ = detail::series_mult_value_t<R1, R2>;
+
+      // The inputs are read strictly in order and every coefficient is kept,
+      // so all copies of the view and all their cursors share one product.
+      // Cursors on different threads take turns under the mutex, which is
+      // recursive for series defined in terms of their own product.
+      struct state
+      {
+        std::recursive_mutex mutex_;
+        R1 r1_;
+        R2 r2_;
+        range_iterator_t<R1> it1_;
+        range_iterator_t<R2> it2_;
+        std::size_t n1_;
+        std::size_t n2_;
+        detail::relaxed_product<value_type_> product_;
+
+        state(R1 r1, R2 r2)
+          : r1_(std::move(r1))
+          , r2_(std::move(r2))
+          , it1_(begin(r1_))
+          , it2_(begin(r2_))
+          , n1_{0}
+          , n2_{0}
+        {}
+
+        // compute up to coefficient n; false if the product is shorter
+        bool reach(std::size_t n)
+        {
+          std::lock_guard<std::recursive_mutex> lock{mutex_};
+          while (product_.size() <= n)
+          {
+            bool more1 = it1_ != end(r1_);
+            bool more2 = it2_ != end(r2_);
+            // a product with an empty series is empty
+            if ((!more1 && n1_ == 0) || (!more2 && n2_ == 0))
+              return false;
+            if (!more1 && !more2 && product_.size() + 1 >= n1_ + n2_)
+              return false;
+            value_type_ x{};
+            value_type_ y{};
+            if (more1)
+            {
+              x = *it1_;
+              ++it1_;
+              ++n1_;
+            }
+            if (more2)
+            {
+              y = *it2_;
+              ++it2_;
+              ++n2_;
+            }
+            product_.push(std::move(x), std::move(y));
+          }
+          return true;
+        }
+
+        value_type_ at(std::size_t n)
+        {
+          std::lock_guard<std::recursive_mutex> lock{mutex_};
+          reach(n);
+          return product_[n];
+        }
+      };
+      std::shared_ptr<state> state_;
+
+      struct cursor
+      {
+        using difference_type = difference_type_;
+      private:
+        state *state_;
+        difference_type n_;
+
+        std::size_t index() const
+        {
+          return static_cast<std::size_t>(n_);
+        }
+      public:
+        cursor() = default;
+        cursor(state &s)
+          : state_{&s}
+          , n_{0}
+        {}
+        value_type_ current() const
+        {
+          return state_->at(index());
+        }
+        bool done() const
+        {
+          return !state_->reach(index());
+        }
+        void next()
+        {
+          ++n_;
+        }
+        void prev()
+        {
+          --n_;
+        }
+        void advance(difference_type n)
+        {
+          n_ += n;
+        }
+        bool equal(cursor const &that) const
+        {
+          return n_ == that.n_;
+        }
+        difference_type distance_to(cursor const &that) const
+        {
+          return that.n_ - n_;
+        }
+      };
+
+      cursor begin_cursor() const
+      {
+        return {*state_};
+      }
+
+    public:
+      relaxed_mult_view() = default;
+      explicit relaxed_mult_view(R1 r1, R2 r2)
+        : state_{std::make_shared<state>(std::move(r1), std::move(r2))}
+      {}
+    };
+
+    namespace view
+    {
+      struct relaxed_mult_fn
+      {
+        template<typename R1, typename R2>
+        using Concept = meta::and_<InputRange<R1>, InputRange<R2>>;
+
+        template<typename R1, typename R2,
+                 CONCEPT_REQUIRES_(Concept<R1, R2>())>
+        relaxed_mult_view<all_t<R1>, all_t<R2>> operator()(
+            R1 && r1, R2 && r2) const
+        {
+          return relaxed_mult_view<all_t<R1>, all_t<R2>>{
+              all(std::forward<R1>(r1)),
+              all(std::forward<R2>(r2))
+          };
+        }
+
+#ifndef RANGES_DOXYGEN_INVOKED
+        template<typename R1, typename R2,
+                 CONCEPT_REQUIRES_(!Concept<R1, R2>())>
+        void operator()(R1 &&, R2 &&) const
+        {
+          CONCEPT_ASSERT_MSG(meta::and_<InputRange<R1>, InputRange<R2>>(),
+                             "All of the objects passed to view::relaxed_mult must model "
+                             "the InputRange concept");
+        }
+#endif
+      };
+
+      namespace
+      {
+        constexpr auto&& relaxed_mult = static_const<relaxed_mult_fn>::value;
+      }
+
+    } // namespace view
+  }  // inline namespace v3
+} // namespace ranges
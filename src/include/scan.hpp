@@ -1,9 +1,16 @@
 #pragma once
 
+#include "series_fill.hpp"
+
 #include <range/v3/utility/semiregular.hpp>
 #include <range/v3/view/all.hpp>
 #include <range/v3/numeric/accumulate.hpp>
 
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
 namespace ranges
 {
   inline namespace v3
@@ -66,17 +73,21 @@ namespace ranges
         (
           val_
         )
+        // The last value is the fold of the whole range; stepping past it
+        // reads nothing more.
         void next()
         {
-          update_value();
           if (it_ != end(rng_->r_))
+          {
+            update_value();
             ++it_;
+          }
           else
             done_ = true;
         }
         bool equal(cursor const &that) const
         {
-          return it_ == that.it_;
+          return it_ == that.it_ && done_ == that.done_;
         }
       private:
         void update_value()
@@ -116,12 +127,12 @@ namespace ranges
       }
 
       CONCEPT_REQUIRES((bool) Range<Rng const>())
-      cursor<true> begin_cursor()
+      cursor<true> begin_cursor() const
       {
         return {*this};
       }
       CONCEPT_REQUIRES((bool) Range<Rng const>())
-      sentinel<true> end_cursor()
+      sentinel<true> end_cursor() const
       {
         return {*this};
       }
@@ -141,6 +152,215 @@ namespace ranges
           static_cast<size_type_>(detail::scan_cardinality<range_cardinality<Rng>>::value) :
           ranges::size(r_) + 1;
       }
+      // the input in bulk, then one pass of the fold over the array
+      template<typename U,
+               CONCEPT_REQUIRES_(Range<Rng const>())>
+      std::size_t fill(U *out, std::size_t n) const
+      {
+        if (n == 0)
+          return 0;
+        std::vector<range_value_t<Rng>> in(n - 1);
+        in.resize(series_fill(r_, in.data(), n - 1));
+        T val = init_;
+        out[0] = val;
+        for (std::size_t i = 0; i < in.size(); ++i)
+        {
+          val = op_(val, proj_(in[i]));
+          out[i + 1] = val;
+        }
+        return in.size() + 1;
+      }
+    };
+
+    // A scan that records every k-th value as its cursors pass it, in a
+    // table shared by all copies of the view. A cursor can then jump to any
+    // element by restarting from the checkpoint before it and folding at
+    // most k-1 more elements, so indexing costs O(k) once the table
+    // reaches that far, and a new cursor need not repeat an earlier fold.
+    // Larger k means a smaller table and slower jumps.
+    template<typename Rng, typename T, typename Op, typename P>
+    struct checkpointed_scan_view
+      : view_facade<checkpointed_scan_view<Rng, T, Op, P>,
+                    detail::scan_cardinality<range_cardinality<Rng>>::value>
+    {
+    private:
+      friend struct range_access;
+      using difference_type_ = range_difference_t<Rng>;
+      using size_type_ = meta::eval<std::make_unsigned<difference_type_>>;
+
+      // the values of elements 0, k, 2k, ... found so far
+      struct checkpoints
+      {
+        std::mutex mutex_;
+        std::vector<T> values_;
+      };
+
+      Rng r_;
+      T init_;
+      semiregular_t<function_type<Op>> op_;
+      semiregular_t<function_type<P>> proj_;
+      difference_type_ k_;
+      std::shared_ptr<checkpoints> checkpoints_;
+
+      void record(difference_type_ i, T const &val) const
+      {
+        if (i % k_ != 0)
+          return;
+        std::lock_guard<std::mutex> lock{checkpoints_->mutex_};
+        auto &values = checkpoints_->values_;
+        if (static_cast<difference_type_>(values.size()) == i / k_)
+          values.push_back(val);
+      }
+
+      // the index of the last checkpoint at or before element i, whose
+      // value is stored in val
+      difference_type_ checkpoint(difference_type_ i, T &val) const
+      {
+        std::lock_guard<std::mutex> lock{checkpoints_->mutex_};
+        auto &values = checkpoints_->values_;
+        auto j = detail::min_(i / k_, static_cast<difference_type_>(values.size()) - 1);
+        val = values[static_cast<std::size_t>(j)];
+        return j * k_;
+      }
+
+      template <bool IsConst>
+      struct sentinel;
+
+      template <bool IsConst>
+      struct cursor
+      {
+        using difference_type = range_difference_t<Rng>;
+      private:
+        friend struct sentinel<IsConst>;
+        template <typename C>
+        using constify_if = meta::apply<meta::add_const_if_c<IsConst>, C>;
+        using scan_view_t = constify_if<checkpointed_scan_view>;
+        scan_view_t *rng_;
+        range_iterator_t<constify_if<Rng>> it_;
+        T val_;
+        difference_type pos_;
+        bool done_;
+      public:
+        cursor() = default;
+        cursor(scan_view_t &rng)
+          : rng_{&rng}
+          , it_{begin(rng.r_)}
+          , val_{rng.init_}
+          , pos_{0}
+          , done_{false}
+        {}
+        auto current() const
+        RANGES_DECLTYPE_AUTO_RETURN_NOEXCEPT
+        (
+          val_
+        )
+        void next()
+        {
+          ++pos_;
+          if (it_ != end(rng_->r_))
+          {
+            val_ = rng_->op_(val_, rng_->proj_(*it_));
+            ++it_;
+            rng_->record(pos_, val_);
+          }
+          else
+            done_ = true;
+        }
+        void prev()
+        {
+          advance(-1);
+        }
+        void advance(difference_type n)
+        {
+          difference_type target = pos_ + n;
+          // restart from a checkpoint if going back, or if one is nearer
+          if (n < 0 || n > rng_->k_)
+          {
+            T val = val_;
+            difference_type p = rng_->checkpoint(target, val);
+            if (n < 0 || p > pos_)
+            {
+              it_ = begin(rng_->r_) + p;
+              val_ = std::move(val);
+              pos_ = p;
+              done_ = false;
+            }
+          }
+          while (pos_ < target)
+            next();
+        }
+        bool equal(cursor const &that) const
+        {
+          return pos_ == that.pos_;
+        }
+        difference_type distance_to(cursor const &that) const
+        {
+          return that.pos_ - pos_;
+        }
+      private:
+        bool done() const
+        {
+          return done_;
+        }
+      };
+
+      template <bool IsConst>
+      struct sentinel
+      {
+      private:
+        template <typename C>
+        using constify_if = meta::apply<meta::add_const_if_c<IsConst>, C>;
+        using scan_view_t = constify_if<checkpointed_scan_view>;
+      public:
+        sentinel() = default;
+        sentinel(scan_view_t &)
+        {}
+        bool equal(cursor<IsConst> const &pos) const
+        {
+          return pos.done();
+        }
+      };
+
+      cursor<false> begin_cursor()
+      {
+        return {*this};
+      }
+      sentinel<false> end_cursor()
+      {
+        return {*this};
+      }
+
+      CONCEPT_REQUIRES((bool) Range<Rng const>())
+      cursor<true> begin_cursor() const
+      {
+        return {*this};
+      }
+      CONCEPT_REQUIRES((bool) Range<Rng const>())
+      sentinel<true> end_cursor() const
+      {
+        return {*this};
+      }
+
+    public:
+      checkpointed_scan_view() = default;
+      explicit checkpointed_scan_view(Rng r, T t, std::size_t k, Op op, P proj)
+        : r_(std::move(r))
+        , init_(std::move(t))
+        , op_(as_function(std::move(op)))
+        , proj_(as_function(std::move(proj)))
+        , k_(static_cast<difference_type_>(k))
+        , checkpoints_(std::make_shared<checkpoints>())
+      {
+        RANGES_ASSERT(k > 0);
+        checkpoints_->values_.push_back(init_);
+      }
+      CONCEPT_REQUIRES((bool) SizedRange<Rng>())
+      constexpr size_type_ size() const
+      {
+        return detail::scan_cardinality<range_cardinality<Rng>>::value > 0 ?
+          static_cast<size_type_>(detail::scan_cardinality<range_cardinality<Rng>>::value) :
+          ranges::size(r_) + 1;
+      }
     };
 
     namespace view
@@ -169,6 +389,33 @@ namespace ranges
       {
         constexpr auto&& scan = static_const<with_braced_init_args<scan_fn>>::value;
       }
+
+      struct checkpointed_scan_fn
+      {
+        template<typename Rng, typename T, typename Op, typename P>
+        using Concept = meta::and_<RandomAccessRange<Rng>,
+                                   Accumulateable<range_iterator_t<Rng>, T, Op, P>>;
+
+        template<typename Rng, typename T, typename Op = plus, typename P = ident,
+                 CONCEPT_REQUIRES_(Concept<Rng, T, Op, P>())>
+        checkpointed_scan_view<all_t<Rng>, T, Op, P> operator()(
+            Rng&& r, T init, std::size_t k, Op op = Op{}, P proj = P{}) const
+        {
+          return checkpointed_scan_view<all_t<Rng>, T, Op, P>{
+              all(std::forward<Rng>(r)),
+              std::move(init),
+              k,
+              std::move(op),
+              std::move(proj)
+          };
+        }
+      };
+
+      namespace
+      {
+        constexpr auto&& checkpointed_scan =
+          static_const<with_braced_init_args<checkpointed_scan_fn>>::value;
+      }
     }
   }
 }
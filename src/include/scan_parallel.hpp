@@ -0,0 +1,102 @@
+#pragma once
+
+#include "simd.hpp"
+#include "thread_pool.hpp"
+
+#include <range/v3/core.hpp>
+#include <range/v3/numeric/accumulate.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace ranges
+{
+  inline namespace v3
+  {
+    namespace detail
+    {
+      // a plain running sum of 32-bit integers, between arrays
+      template <typename I, typename O, typename T, typename Op, typename P>
+      using scan_parallel_is_simd =
+        meta::and_c<std::is_same<T, std::int32_t>::value,
+                    std::is_same<Op, plus>::value,
+                    std::is_same<P, ident>::value,
+                    is_contiguous_iterator_of<I, T>::value,
+                    is_contiguous_iterator_of<O, T>::value,
+                    !std::is_const<meta::eval<std::remove_reference<
+                       decltype(*std::declval<O>())>>>::value>;
+
+      // out[i] = carry op proj(first[0]) op ... op proj(first[i])
+      template <typename I, typename O, typename T, typename Op, typename P>
+      void scan_block(I first, std::size_t n, T carry, O out, Op &op, P &proj,
+                      std::false_type)
+      {
+        for (std::size_t i = 0; i < n; ++i, ++first, ++out)
+        {
+          carry = op(carry, proj(*first));
+          *out = carry;
+        }
+      }
+
+      template <typename I, typename O, typename T, typename Op, typename P>
+      void scan_block(I first, std::size_t n, T carry, O out, Op &, P &,
+                      std::true_type)
+      {
+        if (n > 0)
+          inclusive_scan(&*first, n, carry, &*out);
+      }
+    } // namespace detail
+
+    // Writes the size(rng) + 1 elements of view::scan(rng, init, op, proj)
+    // to out, sharing the work over the pool, and returns the end of the
+    // output. op must be associative: the input is cut into a block per
+    // thread, each block is reduced, the reductions are scanned to give
+    // each block its starting value, and then each block is scanned from
+    // it. Each element is thus folded twice; 32-bit integer sums between
+    // arrays run a vectorized scan for the second pass. Floating point
+    // sums are not associative, so they may round differently from the
+    // sequential scan.
+    template <typename Rng, typename T, typename Op, typename P, typename O,
+              CONCEPT_REQUIRES_(RandomAccessRange<Rng>() && SizedRange<Rng>())>
+    O scan_parallel(Rng &&rng, T init, Op op, P proj, O out, thread_pool &pool)
+    {
+      auto &&fun = as_function(op);
+      auto &&pr = as_function(proj);
+      auto first = begin(rng);
+      auto n = static_cast<std::size_t>(ranges::size(rng));
+      *out = init;
+      ++out;
+      if (n == 0)
+        return out;
+
+      std::size_t blocks = std::min(n, pool.size());
+      auto bound = [&] (std::size_t b) {
+        return static_cast<range_difference_t<Rng>>(n * b / blocks);
+      };
+
+      // the last block's reduction isn't needed
+      std::vector<T> carries(blocks, init);
+      pool.run(blocks - 1, [&] (std::size_t b) {
+          auto it = first + bound(b);
+          auto last = first + bound(b + 1);
+          T acc = pr(*it);
+          for (++it; it != last; ++it)
+            acc = fun(acc, pr(*it));
+          carries[b + 1] = std::move(acc);
+        });
+      for (std::size_t b = 1; b < blocks; ++b)
+        carries[b] = fun(carries[b - 1], carries[b]);
+
+      using simd_t = detail::scan_parallel_is_simd<decltype(first), O, T, Op, P>;
+      pool.run(blocks, [&] (std::size_t b) {
+          detail::scan_block(first + bound(b),
+                             static_cast<std::size_t>(bound(b + 1) - bound(b)),
+                             carries[b], out + bound(b), fun, pr, simd_t{});
+        });
+      return out + static_cast<range_difference_t<Rng>>(n);
+    }
+  }  // inline namespace v3
+} // namespace ranges
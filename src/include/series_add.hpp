@@ -0,0 +1,175 @@
+#pragma once
+
+#include "series_mult.hpp"
+
+#include <range/v3/core.hpp>
+#include <range/v3/view/all.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+namespace ranges
+{
+  inline namespace v3
+  {
+    namespace detail
+    {
+      // sums of sized arithmetic arrays can run on raw pointers
+      template<typename R1, typename R2,
+               typename T = common_type_t<range_value_t<R1>, range_value_t<R2>>>
+      using series_add_is_contiguous =
+        meta::and_c<std::is_arithmetic<T>::value,
+                    (bool) SizedRange<R1>(),
+                    (bool) SizedRange<R2>(),
+                    is_contiguous_iterator_of<range_iterator_t<R1>, T>::value,
+                    is_contiguous_iterator_of<range_iterator_t<R2>, T>::value>;
+
+      // out[0, max(na, nb)) = a op b, where the shorter input is padded with
+      // zeros. Plain loops over pointers, which the compiler vectorizes;
+      // out may be a or b.
+      template <typename T, typename Op>
+      void series_add(T const *a, std::size_t na,
+                      T const *b, std::size_t nb,
+                      T *out, Op op)
+      {
+        std::size_t n = std::min(na, nb);
+        for (std::size_t i = 0; i < n; ++i)
+          out[i] = static_cast<T>(op(a[i], b[i]));
+        if (out != a)
+          std::copy(a + n, a + na, out + n);
+        for (std::size_t i = n; i < nb; ++i)
+          out[i] = static_cast<T>(op(T{}, b[i]));
+      }
+
+      template <typename Rng>
+      auto data_of(Rng const &r)
+      {
+        return ranges::size(r) > 0 ? &*ranges::begin(r) : nullptr;
+      }
+    } // namespace detail
+
+    // The sum (or difference) of two contiguous arithmetic series, computed
+    // in one pass over arrays by the first cursor to need it and shared by
+    // all copies of the view. A limit stops it after that many coefficients.
+    // The sum is a snapshot: the inputs are read once, so changes to them
+    // after the view is first read aren't seen.
+    template<typename R1, typename R2, typename Op>
+    struct series_add_view
+      : view_facade<series_add_view<R1, R2, Op>, finite>
+    {
+    private:
+      CONCEPT_ASSERT(detail::series_add_is_contiguous<R1, R2>());
+      friend range_access;
+      R1 r1_;
+      R2 r2_;
+      std::size_t limit_ = static_cast<std::size_t>(-1);
+
+      using value_type_ = common_type_t<range_value_t<R1>, range_value_t<R2>>;
+
+      struct sum_state
+      {
+        std::once_flag once_;
+        std::vector<value_type_> coefficients_;
+      };
+      std::shared_ptr<sum_state> sum_;
+
+      std::vector<value_type_> const &sum() const
+      {
+        std::call_once(sum_->once_, [this] {
+            auto na = std::min<std::size_t>(ranges::size(r1_), limit_);
+            auto nb = std::min<std::size_t>(ranges::size(r2_), limit_);
+            auto &v = sum_->coefficients_;
+            v.resize(std::max(na, nb));
+            detail::series_add(detail::data_of(r1_), na,
+                               detail::data_of(r2_), nb,
+                               v.data(), Op{});
+          });
+        return sum_->coefficients_;
+      }
+
+      struct cursor
+      {
+        using difference_type = std::ptrdiff_t;
+      private:
+        value_type_ const *p_;
+      public:
+        cursor() = default;
+        explicit cursor(value_type_ const *p)
+          : p_{p}
+        {}
+        value_type_ current() const
+        {
+          return *p_;
+        }
+        void next()
+        {
+          ++p_;
+        }
+        void prev()
+        {
+          --p_;
+        }
+        void advance(difference_type n)
+        {
+          p_ += n;
+        }
+        bool equal(cursor const &that) const
+        {
+          return p_ == that.p_;
+        }
+        difference_type distance_to(cursor const &that) const
+        {
+          return that.p_ - p_;
+        }
+      };
+
+      cursor begin_cursor() const
+      {
+        return cursor{sum().data()};
+      }
+      cursor end_cursor() const
+      {
+        auto &v = sum();
+        return cursor{v.data() + v.size()};
+      }
+    public:
+      series_add_view() = default;
+      explicit series_add_view(R1 r1, R2 r2)
+        : r1_{std::move(r1)}
+        , r2_{std::move(r2)}
+        , sum_{std::make_shared<sum_state>()}
+      {}
+      explicit series_add_view(R1 r1, R2 r2, std::size_t limit)
+        : r1_{std::move(r1)}
+        , r2_{std::move(r2)}
+        , limit_{limit}
+        , sum_{std::make_shared<sum_state>()}
+      {}
+      std::size_t size() const
+      {
+        return std::min<std::size_t>(
+            std::max<std::size_t>(ranges::size(r1_), ranges::size(r2_)), limit_);
+      }
+      R1 const &base1() const
+      {
+        return r1_;
+      }
+      R2 const &base2() const
+      {
+        return r2_;
+      }
+      template<typename T>
+      std::size_t fill(T *out, std::size_t n) const
+      {
+        auto &v = sum();
+        std::size_t k = std::min(n, v.size());
+        std::copy(v.begin(), v.begin() + static_cast<std::ptrdiff_t>(k), out);
+        return k;
+      }
+    };
+  }  // inline namespace v3
+} // namespace ranges
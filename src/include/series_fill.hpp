@@ -0,0 +1,45 @@
+#pragma once
+
+#include <range/v3/core.hpp>
+
+#include <cstddef>
+
+namespace ranges
+{
+  inline namespace v3
+  {
+    namespace detail
+    {
+      // views that produce coefficients in bulk
+      template <typename Rng, typename T>
+      auto series_fill(Rng &rng, T *out, std::size_t n, int)
+        -> decltype(rng.fill(out, n))
+      {
+        return rng.fill(out, n);
+      }
+
+      // anything else, a coefficient at a time
+      template <typename Rng, typename T>
+      std::size_t series_fill(Rng &rng, T *out, std::size_t n, long)
+      {
+        std::size_t i = 0;
+        auto it = begin(rng);
+        auto e = end(rng);
+        for (; i < n && it != e; ++i, ++it)
+          out[i] = *it;
+        return i;
+      }
+    } // namespace detail
+
+    // Writes the first n coefficients of rng to out (all of them, if rng is
+    // shorter) and returns how many it wrote. A view that can produce its
+    // coefficients a block at a time, with loops over arrays that the
+    // compiler can vectorize, does so through a member fill(out, n) with
+    // the same contract; other ranges are read a coefficient at a time.
+    template <typename Rng, typename T>
+    std::size_t series_fill(Rng &&rng, T *out, std::size_t n)
+    {
+      return detail::series_fill(rng, out, n, 0);
+    }
+  }  // inline namespace v3
+} // namespace ranges
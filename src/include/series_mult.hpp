@@ -1,13 +1,41 @@
 #pragma once
 
+#include "fft.hpp"
+#include "karatsuba.hpp"
+#include "series_fill.hpp"
+#include "simd.hpp"
+
 #include <range/v3/numeric/inner_product.hpp>
 #include <range/v3/view/all.hpp>
 #include <range/v3/view/reverse.hpp>
 
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
 namespace ranges
 {
   inline namespace v3
   {
+    // How series_mult computes the product of sized, random-access inputs.
+    // Other inputs are always multiplied lazily, one coefficient at a time.
+    namespace series_mult_strategy
+    {
+      // pick by operand size and coefficient type
+      struct automatic {};
+      // an inner product per coefficient, computed as the cursor moves
+      struct naive {};
+      // Karatsuba, bottoming out in the schoolbook product
+      struct karatsuba {};
+      // complex FFT for floating point, NTT for integer and modular; 64-bit
+      // integers overflow the NTT, so they get Karatsuba
+      struct fft {};
+    }
+
     namespace detail
     {
       template<typename C1, typename C2>
@@ -20,11 +48,159 @@ namespace ranges
               C1::value >= 0 && C2::value >= 0 ?
                 static_cast<ranges::cardinality>(C1::value + C2::value - 1) :
                 finite>;
+
+      template<typename R1, typename R2>
+      using series_mult_value_t = common_type_t<range_value_t<R1>,
+                                                range_value_t<R2>>;
+
+      // sized, random-access inputs are multiplied up front by a subquadratic
+      // kernel rather than one inner product per coefficient
+      template<typename R1, typename R2, typename Strategy>
+      using series_mult_is_eager =
+        meta::and_c<(bool) SizedRange<R1>(),
+                    (bool) SizedRange<R2>(),
+                    (bool) RandomAccessRange<R1>(),
+                    (bool) RandomAccessRange<R2>(),
+                    !std::is_same<Strategy, series_mult_strategy::naive>::value>;
+
+      // the lazy inner product can run on raw arithmetic arrays; contiguous
+      // inputs are sized and random-access, so other strategies multiply
+      // them up front, and this is the naive strategy's path
+      template <typename I1, typename I2, typename T>
+      using series_mult_is_contiguous =
+        meta::and_c<std::is_arithmetic<T>::value,
+                    is_contiguous_iterator_of<I1, T>::value,
+                    is_contiguous_iterator_of<I2, T>::value>;
+
+      // out[0, hi-lo) = coefficients [lo, hi) of a * b, for na, nb <= hi
+      // and hi <= na + nb - 1
+      template <typename T>
+      void series_mult_range(T const *a, std::size_t na,
+                             T const *b, std::size_t nb,
+                             T *out, std::size_t lo, std::size_t hi, std::false_type)
+      {
+        karatsuba_mult_range(a, na, b, nb, out, lo, hi);
+      }
+      template <typename T>
+      void series_mult_range(T const *a, std::size_t na,
+                             T const *b, std::size_t nb,
+                             T *out, std::size_t lo, std::size_t hi, std::true_type)
+      {
+        if (fft_middle_size(na, nb, lo, hi) > ntt_max_size)
+          karatsuba_mult_range(a, na, b, nb, out, lo, hi);
+        else
+          fft_mult(a, na, b, nb, out, lo, hi);
+      }
+
+      // out[0, na+nb-1) = a * b
+      template <typename T>
+      void series_mult_product(T const *a, std::size_t na,
+                               T const *b, std::size_t nb,
+                               T *out, series_mult_strategy::karatsuba)
+      {
+        karatsuba_mult(a, na, b, nb, out);
+      }
+
+      template <typename T>
+      void series_mult_product(T const *a, std::size_t na,
+                               T const *b, std::size_t nb,
+                               T *out, series_mult_strategy::fft)
+      {
+        static_assert(is_fft_coefficient<T>::value,
+                      "series_mult_strategy::fft needs arithmetic or modular coefficients");
+        if (na == 0 || nb == 0)
+          return;
+        series_mult_range(a, na, b, nb, out, 0, na + nb - 1, fft_applies<T>{});
+      }
+
+      template <typename T>
+      void series_mult_product(T const *a, std::size_t na,
+                               T const *b, std::size_t nb,
+                               T *out, series_mult_strategy::automatic, std::false_type)
+      {
+        karatsuba_mult(a, na, b, nb, out);
+      }
+      template <typename T>
+      void series_mult_product(T const *a, std::size_t na,
+                               T const *b, std::size_t nb,
+                               T *out, series_mult_strategy::automatic, std::true_type)
+      {
+        if (std::min(na, nb) >= fft_cutoff<T>::value)
+          series_mult_product(a, na, b, nb, out, series_mult_strategy::fft{});
+        else
+          karatsuba_mult(a, na, b, nb, out);
+      }
+
+      template <typename T>
+      void series_mult_product(T const *a, std::size_t na,
+                               T const *b, std::size_t nb,
+                               T *out, series_mult_strategy::automatic)
+      {
+        series_mult_product(a, na, b, nb, out, series_mult_strategy::automatic{},
+                            fft_applies<T>{});
+      }
+
+      template <typename T>
+      void series_mult_range(T const *a, std::size_t na,
+                             T const *b, std::size_t nb,
+                             T *out, std::size_t lo, std::size_t hi,
+                             series_mult_strategy::karatsuba)
+      {
+        karatsuba_mult_range(a, na, b, nb, out, lo, hi);
+      }
+      template <typename T>
+      void series_mult_range(T const *a, std::size_t na,
+                             T const *b, std::size_t nb,
+                             T *out, std::size_t lo, std::size_t hi,
+                             series_mult_strategy::fft)
+      {
+        static_assert(is_fft_coefficient<T>::value,
+                      "series_mult_strategy::fft needs arithmetic or modular coefficients");
+        series_mult_range(a, na, b, nb, out, lo, hi, fft_applies<T>{});
+      }
+      template <typename T>
+      void series_mult_range(T const *a, std::size_t na,
+                             T const *b, std::size_t nb,
+                             T *out, std::size_t lo, std::size_t hi,
+                             series_mult_strategy::automatic)
+      {
+        if (std::min(na, nb) >= fft_cutoff<T>::value)
+          series_mult_range(a, na, b, nb, out, lo, hi, fft_applies<T>{});
+        else
+          karatsuba_mult_range(a, na, b, nb, out, lo, hi);
+      }
+
+      // The middle product: out[0, hi-lo) = coefficients [lo, hi) of a * b,
+      // zero past the end of the product. Only the coefficients asked for
+      // are computed, and the transforms are sized to match (see
+      // fft_middle_size).
+      template <typename T, typename Strategy>
+      void series_mult_middle(T const *a, std::size_t na,
+                              T const *b, std::size_t nb,
+                              T *out, std::size_t lo, std::size_t hi, Strategy s)
+      {
+        na = std::min(na, hi);
+        nb = std::min(nb, hi);
+        std::size_t top = na > 0 && nb > 0 ? std::min(hi, na + nb - 1) : 0;
+        std::fill(out + (top > lo ? top - lo : 0), out + (hi - lo), T{});
+        if (top > lo)
+          series_mult_range(a, na, b, nb, out, lo, top, s);
+      }
+
+      // the short product: out[0, n) = a * b mod x^n
+      template <typename T, typename Strategy>
+      void series_mult_low(T const *a, std::size_t na,
+                           T const *b, std::size_t nb,
+                           T *out, std::size_t n, Strategy s)
+      {
+        series_mult_middle(a, na, b, nb, out, 0, n, s);
+      }
     } // namespace detail
 
-    template<typename R1, typename R2>
+    template<typename R1, typename R2,
+             typename Strategy = series_mult_strategy::automatic>
     struct iter_series_mult_view
-      : view_facade<iter_series_mult_view<R1, R2>,
+      : view_facade<iter_series_mult_view<R1, R2, Strategy>,
                     detail::series_mult_cardinality<
                       range_cardinality<R1>,
                       range_cardinality<R2>>::value>
@@ -38,10 +214,139 @@ namespace ranges
       using difference_type_ = common_type_t<range_difference_t<R1>,
                                              range_difference_t<R2>>;
       using size_type_ = meta::eval<std::make_unsigned<difference_type_>>;
+      using value_type_ = detail::series_mult_value_t<R1, R2>;
+      using eager_t = detail::series_mult_is_eager<R1, R2, Strategy>;
+
+      // The product of sized, random-access inputs, computed by the first
+      // cursor to need it and shared by all copies of the view. Nothing is
+      // computed for a view that is only used to build another (as
+      // truncate does). It is a snapshot: the inputs are read once, so
+      // changes to them after the view is first read aren't seen.
+      struct product_state
+      {
+        std::once_flag once_;
+        std::vector<value_type_> coefficients_;
+      };
+      std::shared_ptr<product_state> product_;
+      // at most this many coefficients are computed up front
+      std::size_t limit_ = static_cast<std::size_t>(-1);
+
+      template <typename Rng>
+      static std::vector<value_type_> coefficients(Rng &r)
+      {
+        auto n = ranges::size(r);
+        std::vector<value_type_> v;
+        v.reserve(n);
+        auto it = begin(r);
+        for (decltype(n) i = 0; i < n; ++i, ++it)
+          v.push_back(*it);
+        return v;
+      }
+
+      void make_product_state(std::false_type)
+      {}
+      void make_product_state(std::true_type)
+      {
+        product_ = std::make_shared<product_state>();
+      }
+
+      void compute_product(std::vector<value_type_> &product) const
+      {
+        auto a = coefficients(r1_);
+        auto b = coefficients(r2_);
+        auto n = a.size() + b.size();
+        n = n > 0 ? n - 1 : 0;
+        if (n <= limit_)
+        {
+          product.resize(n);
+          detail::series_mult_product(a.data(), a.size(), b.data(), b.size(),
+                                      product.data(), Strategy{});
+          return;
+        }
+        product.resize(limit_);
+        detail::series_mult_low(a.data(), a.size(), b.data(), b.size(),
+                                product.data(), limit_, Strategy{});
+      }
+
+      std::vector<value_type_> const &product() const
+      {
+        std::call_once(product_->once_,
+                       [this] { compute_product(product_->coefficients_); });
+        return product_->coefficients_;
+      }
+
+      // lazy cursors jump in O(1) over random-access inputs whose ends are
+      // known
+      using are_random_access_t =
+        meta::and_c<(bool) RandomAccessRange<R1>(),
+                    (bool) RandomAccessRange<R2>(),
+                    (bool) SizedRange<R1>() || range_cardinality<R1>::value == infinite,
+                    (bool) SizedRange<R2>() || range_cardinality<R2>::value == infinite>;
+
+      template <typename Rng>
+      using is_sized_t = std::integral_constant<bool, (bool) SizedRange<Rng>()>;
+      template <typename Rng>
+      static difference_type_ extent(Rng &r, std::true_type)
+      {
+        return static_cast<difference_type_>(ranges::size(r));
+      }
+      template <typename Rng>
+      static difference_type_ extent(Rng &, std::false_type)
+      {
+        return std::numeric_limits<difference_type_>::max();
+      }
 
       template <bool IsConst>
       struct sentinel;
 
+      // walks the precomputed product of sized, random-access inputs
+      template <bool IsConst>
+      struct product_cursor
+      {
+        using difference_type = difference_type_;
+      private:
+        template <typename T>
+        using constify_if = meta::apply<meta::add_const_if_c<IsConst>, T>;
+        using series_mult_view_t = constify_if<iter_series_mult_view>;
+        std::vector<value_type_> const *product_;
+        difference_type n_;
+
+      public:
+        product_cursor() = default;
+        product_cursor(series_mult_view_t &rng, begin_tag)
+          : product_{&rng.product()}
+          , n_{0}
+        {}
+        product_cursor(series_mult_view_t &rng, end_tag)
+          : product_{&rng.product()}
+          , n_{static_cast<difference_type>(product_->size())}
+        {}
+        value_type_ current() const
+        {
+          return (*product_)[static_cast<std::size_t>(n_)];
+        }
+        void next()
+        {
+          ++n_;
+        }
+        void prev()
+        {
+          --n_;
+        }
+        void advance(difference_type n)
+        {
+          n_ += n;
+        }
+        bool equal(product_cursor const &that) const
+        {
+          return n_ == that.n_;
+        }
+        difference_type distance_to(product_cursor const &that) const
+        {
+          return that.n_ - n_;
+        }
+      };
+
       template <bool IsConst>
       struct cursor
       {
@@ -79,17 +384,32 @@ namespace ranges
                 detail::distance_to(begin(rng.r2_), it2_)}
           , tail_{length_}
         {}
+        template <typename I1, typename I2>
+        value_type_ inner_product(I1 first1, I2 first2, std::false_type) const
+        {
+          auto r1 = make_range(first1, it1_);
+          auto r2 = view::reverse(make_range(first2, it2_));
+          return ranges::inner_product(r1, r2, value_type_{});
+        }
+        template <typename I1, typename I2>
+        value_type_ inner_product(I1 first1, I2 first2, std::true_type) const
+        {
+          auto n = static_cast<std::size_t>(it1_ - first1);
+          if (n == 0)
+            return value_type_{};
+          value_type_ const *a = &*first1;
+          value_type_ const *b = &*first2;
+          return detail::reversed_dot(a, b, n);
+        }
+
         auto compute_current() const
         {
-          auto r1 =  make_range(
-              begin(rng_->r1_) + tail_ + (diff_ > 0 ? diff_ : 0),
-              it1_);
-          auto r2 = view::reverse(
-              make_range(
-                  begin(rng_->r2_) + tail_ + (diff_ < 0 ? -diff_ : 0),
-                  it2_));
-
-          return ranges::inner_product(r1, r2, 0);
+          auto first1 = begin(rng_->r1_) + tail_ + (diff_ > 0 ? diff_ : 0);
+          auto first2 = begin(rng_->r2_) + tail_ + (diff_ < 0 ? -diff_ : 0);
+          return inner_product(
+              first1, first2,
+              detail::series_mult_is_contiguous<decltype(first1), decltype(first2),
+                                                value_type_>{});
         }
 
         auto current() const
@@ -159,13 +479,31 @@ namespace ranges
           --it1_;
           --it2_;
         }
-        CONCEPT_REQUIRES(meta::and_c<(bool) RandomAccessRange<R1>(),
-                                     (bool) RandomAccessRange<R2>()>::value)
+        // The number of steps taken from before the first coefficient:
+        // length_ while both inputs last, then |diff_| more until the
+        // longer one ends, then tail_.
+        difference_type position() const
+        {
+          return length_ + (diff_ > 0 ? diff_ : -diff_) + tail_;
+        }
+        CONCEPT_REQUIRES(are_random_access_t::value)
+        void advance(difference_type n)
+        {
+          difference_type p = position() + n;
+          difference_type n1 = extent(rng_->r1_, is_sized_t<R1>{});
+          difference_type n2 = extent(rng_->r2_, is_sized_t<R2>{});
+          difference_type i1 = detail::min_(p, n1);
+          difference_type i2 = detail::min_(p, n2);
+          it1_ = begin(rng_->r1_) + i1;
+          it2_ = begin(rng_->r2_) + i2;
+          length_ = detail::min_(i1, i2);
+          diff_ = i1 - i2;
+          tail_ = detail::max_(p - detail::max_(n1, n2), difference_type{0});
+        }
+        CONCEPT_REQUIRES(are_random_access_t::value)
         difference_type distance_to(cursor const &that) const
         {
-          return detail::max_(detail::distance_to(it1_, that.it1_),
-                              detail::distance_to(it2_, that.it2_))
-            + abs(tail_ - that.tail_);
+          return that.position() - position();
         }
       };
 
@@ -195,25 +533,29 @@ namespace ranges
       using are_bounded_t = meta::and_c<(bool) BoundedRange<R1>(),
                                         (bool) BoundedRange<R2>()>;
 
-      cursor<false> begin_cursor()
+      template <bool IsConst>
+      using cursor_t = meta::if_<eager_t, product_cursor<IsConst>, cursor<IsConst>>;
+      template <bool IsConst>
+      using end_cursor_t = meta::if_<meta::or_c<eager_t::value, are_bounded_t::value>,
+                                     cursor_t<IsConst>, sentinel<IsConst>>;
+
+      cursor_t<false> begin_cursor()
       {
         return {*this, begin_tag{}};
       }
-      meta::if_<are_bounded_t, cursor<false>, sentinel<false>>
-      end_cursor()
+      end_cursor_t<false> end_cursor()
       {
         return {*this, end_tag{}};
       }
       CONCEPT_REQUIRES(meta::and_c<(bool) Range<R1 const>(),
                                    (bool) Range<R2 const>()>::value)
-      cursor<true> begin_cursor() const
+      cursor_t<true> begin_cursor() const
       {
         return {*this, begin_tag{}};
       }
       CONCEPT_REQUIRES(meta::and_c<(bool) Range<R1 const>(),
                                    (bool) Range<R2 const>()>::value)
-      meta::if_<are_bounded_t, cursor<true>, sentinel<true>>
-      end_cursor() const
+      end_cursor_t<true> end_cursor() const
       {
         return {*this, end_tag{}};
       }
@@ -222,27 +564,89 @@ namespace ranges
       explicit iter_series_mult_view(R1 r1, R2 r2)
         : r1_{std::move(r1)}
         , r2_{std::move(r2)}
-      {}
+      {
+        make_product_state(eager_t{});
+      }
+      // Only the first limit coefficients are wanted: sized, random-access
+      // inputs are multiplied by a short product. Other inputs are still
+      // multiplied lazily in full, so this doesn't shorten the view itself.
+      explicit iter_series_mult_view(R1 r1, R2 r2, std::size_t limit)
+        : r1_{std::move(r1)}
+        , r2_{std::move(r2)}
+        , limit_{limit}
+      {
+        make_product_state(eager_t{});
+      }
       CONCEPT_REQUIRES(meta::and_c<(bool) SizedRange<R1>(),
                                    (bool) SizedRange<R2>()>::value)
-      constexpr size_type_ size() const
+      size_type_ size() const
       {
-        return detail::series_mult_cardinality<range_cardinality<R1>,
-                                               range_cardinality<R2>>::value > 0 ?
+        size_type_ n =
+          detail::series_mult_cardinality<range_cardinality<R1>,
+                                          range_cardinality<R2>>::value > 0 ?
           static_cast<size_type_>(
               detail::series_mult_cardinality<range_cardinality<R1>,
                                               range_cardinality<R2>>::value) :
               ranges::size(r1_) + ranges::size(r2_) - 1;
+        return eager_t::value && limit_ < n ? static_cast<size_type_>(limit_) : n;
+      }
+      R1 const &base1() const
+      {
+        return r1_;
+      }
+      R2 const &base2() const
+      {
+        return r2_;
+      }
+      template<typename T,
+               CONCEPT_REQUIRES_(Range<R1 const>() && Range<R2 const>())>
+      std::size_t fill(T *out, std::size_t n) const
+      {
+        return fill(out, n, eager_t{});
+      }
+    private:
+      template<typename T>
+      std::size_t fill(T *out, std::size_t n, std::true_type) const
+      {
+        auto &p = product();
+        std::size_t k = std::min(n, p.size());
+        std::copy(p.begin(), p.begin() + static_cast<std::ptrdiff_t>(k), out);
+        return k;
+      }
+      // n coefficients of each input, and the short product of them: the
+      // lazy cursor's inner products, all at once by a fast kernel
+      template<typename T>
+      std::size_t fill(T *out, std::size_t n, std::false_type) const
+      {
+        using strategy_t =
+          meta::if_<std::is_same<Strategy, series_mult_strategy::naive>,
+                    series_mult_strategy::automatic, Strategy>;
+        std::vector<value_type_> a(n);
+        a.resize(series_fill(r1_, a.data(), n));
+        std::vector<value_type_> b(n);
+        b.resize(series_fill(r2_, b.data(), n));
+        if (a.empty() || b.empty())
+          return 0;
+        std::size_t k = std::min(n, a.size() + b.size() - 1);
+        std::vector<value_type_> c(k);
+        detail::series_mult_low(a.data(), a.size(), b.data(), b.size(),
+                                c.data(), k, strategy_t{});
+        std::copy(c.begin(), c.end(), out);
+        return k;
       }
     };
 
-    template<typename R1, typename R2>
+    template<typename R1, typename R2,
+             typename Strategy = series_mult_strategy::automatic>
     struct series_mult_view
-      : iter_series_mult_view<R1, R2>
+      : iter_series_mult_view<R1, R2, Strategy>
     {
       series_mult_view() = default;
       explicit series_mult_view(R1 r1, R2 r2)
-        : iter_series_mult_view<R1, R2>{std::move(r1), std::move(r2)}
+        : iter_series_mult_view<R1, R2, Strategy>{std::move(r1), std::move(r2)}
+      {}
+      explicit series_mult_view(R1 r1, R2 r2, std::size_t limit)
+        : iter_series_mult_view<R1, R2, Strategy>{std::move(r1), std::move(r2), limit}
       {}
     };
 
@@ -255,11 +659,12 @@ namespace ranges
           BidirectionalRange<R1>, BidirectionalRange<R2>>;
 
         template<typename R1, typename R2,
+                 typename Strategy = series_mult_strategy::automatic,
                  CONCEPT_REQUIRES_(Concept<R1, R2>())>
-        iter_series_mult_view<all_t<R1>, all_t<R2>> operator()(
-            R1 && r1, R2 && r2) const
+        iter_series_mult_view<all_t<R1>, all_t<R2>, Strategy> operator()(
+            R1 && r1, R2 && r2, Strategy = Strategy{}) const
         {
-          return iter_series_mult_view<all_t<R1>, all_t<R2>>{
+          return iter_series_mult_view<all_t<R1>, all_t<R2>, Strategy>{
               all(std::forward<R1>(r1)),
               all(std::forward<R2>(r2)),
           };
@@ -267,8 +672,9 @@ namespace ranges
 
 #ifndef RANGES_DOXYGEN_INVOKED
         template<typename R1, typename R2,
+                 typename Strategy = series_mult_strategy::automatic,
                  CONCEPT_REQUIRES_(!Concept<R1, R2>())>
-        void operator()(R1 && r1, R2 && r2) const
+        void operator()(R1 && r1, R2 && r2, Strategy = Strategy{}) const
         {
           CONCEPT_ASSERT_MSG(meta::and_<BidirectionalRange<R1>, BidirectionalRange<R2>>(),
                              "All of the objects passed to view::iter_series_mult must model "
@@ -289,11 +695,12 @@ namespace ranges
           BidirectionalRange<R1>, BidirectionalRange<R2>>;
 
         template<typename R1, typename R2,
+                 typename Strategy = series_mult_strategy::automatic,
                  CONCEPT_REQUIRES_(Concept<R1, R2>())>
-        series_mult_view<all_t<R1>, all_t<R2>> operator()(
-            R1 && r1, R2 && r2) const
+        series_mult_view<all_t<R1>, all_t<R2>, Strategy> operator()(
+            R1 && r1, R2 && r2, Strategy = Strategy{}) const
         {
-          return series_mult_view<all_t<R1>, all_t<R2>>{
+          return series_mult_view<all_t<R1>, all_t<R2>, Strategy>{
               all(std::forward<R1>(r1)),
               all(std::forward<R2>(r2)),
           };
@@ -301,8 +708,9 @@ namespace ranges
 
 #ifndef RANGES_DOXYGEN_INVOKED
         template<typename R1, typename R2,
+                 typename Strategy = series_mult_strategy::automatic,
                  CONCEPT_REQUIRES_(!Concept<R1, R2>())>
-        void operator()(R1 &&, R2 &&) const
+        void operator()(R1 &&, R2 &&, Strategy = Strategy{}) const
         {
           CONCEPT_ASSERT_MSG(meta::and_<BidirectionalRange<R1>, BidirectionalRange<R2>>(),
                              "All of the objects passed to view::series_mult must model "
@@ -0,0 +1,397 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Vectorized kernels over contiguous coefficients. Each has a portable
+// version; AVX2 or SSE2 versions are used for double, float and 32-bit
+// integers when the compiler targets them. x86-64 always has SSE2; AVX2
+// needs -mavx2 or -march (see USE_NATIVE_ARCH in CMakeLists.txt). Several
+// accumulators are kept so that the adds don't serialize on latency,
+// which means floating point sums are not added in sequential order.
+
+namespace ranges
+{
+  inline namespace v3
+  {
+    namespace detail
+    {
+      // iterators that can be used as pointers to T
+      template <typename I, typename T>
+      using is_contiguous_iterator_of =
+        std::integral_constant<bool,
+          std::is_same<I, T *>::value ||
+          std::is_same<I, T const *>::value ||
+          std::is_same<I, typename std::vector<T>::iterator>::value ||
+          std::is_same<I, typename std::vector<T>::const_iterator>::value>;
+
+      // a[0].b[n-1] + a[1].b[n-2] + ... + a[n-1].b[0]
+      template <typename T>
+      T reversed_dot(T const *a, T const *b, std::size_t n)
+      {
+        T s0{}, s1{}, s2{}, s3{};
+        std::size_t i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+          s0 += a[i] * b[n - 1 - i];
+          s1 += a[i + 1] * b[n - 2 - i];
+          s2 += a[i + 2] * b[n - 3 - i];
+          s3 += a[i + 3] * b[n - 4 - i];
+        }
+        for (; i < n; ++i)
+          s0 += a[i] * b[n - 1 - i];
+        return (s0 + s1) + (s2 + s3);
+      }
+
+#if defined(__AVX2__)
+      inline double reversed_dot(double const *a, double const *b, std::size_t n)
+      {
+        __m256d acc0 = _mm256_setzero_pd();
+        __m256d acc1 = _mm256_setzero_pd();
+        std::size_t i = 0;
+        for (; i + 8 <= n; i += 8)
+        {
+          // b[n-4-i, n-i) lane-reversed lines up with a[i, i+4)
+          __m256d y0 = _mm256_permute4x64_pd(_mm256_loadu_pd(b + n - 4 - i), 0x1b);
+          __m256d y1 = _mm256_permute4x64_pd(_mm256_loadu_pd(b + n - 8 - i), 0x1b);
+          acc0 = _mm256_add_pd(acc0, _mm256_mul_pd(_mm256_loadu_pd(a + i), y0));
+          acc1 = _mm256_add_pd(acc1, _mm256_mul_pd(_mm256_loadu_pd(a + i + 4), y1));
+        }
+        double lanes[4];
+        _mm256_storeu_pd(lanes, _mm256_add_pd(acc0, acc1));
+        double s = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+        return s + reversed_dot<double>(a + i, b, n - i);
+      }
+
+      inline float reversed_dot(float const *a, float const *b, std::size_t n)
+      {
+        __m256i const reverse = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+        __m256 acc0 = _mm256_setzero_ps();
+        __m256 acc1 = _mm256_setzero_ps();
+        std::size_t i = 0;
+        for (; i + 16 <= n; i += 16)
+        {
+          __m256 y0 = _mm256_permutevar8x32_ps(_mm256_loadu_ps(b + n - 8 - i), reverse);
+          __m256 y1 = _mm256_permutevar8x32_ps(_mm256_loadu_ps(b + n - 16 - i), reverse);
+          acc0 = _mm256_add_ps(acc0, _mm256_mul_ps(_mm256_loadu_ps(a + i), y0));
+          acc1 = _mm256_add_ps(acc1, _mm256_mul_ps(_mm256_loadu_ps(a + i + 8), y1));
+        }
+        float lanes[8];
+        _mm256_storeu_ps(lanes, _mm256_add_ps(acc0, acc1));
+        float s = ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3]))
+          + ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+        return s + reversed_dot<float>(a + i, b, n - i);
+      }
+
+      // products and sums wrap, as they do for the scalar loop in practice
+      inline std::int32_t reversed_dot(std::int32_t const *a, std::int32_t const *b,
+                                       std::size_t n)
+      {
+        __m256i const reverse = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+        __m256i acc0 = _mm256_setzero_si256();
+        __m256i acc1 = _mm256_setzero_si256();
+        std::size_t i = 0;
+        for (; i + 16 <= n; i += 16)
+        {
+          // loaded by memcpy: the intrinsic loads take __m256i pointers
+          __m256i x0, x1, y0, y1;
+          std::memcpy(&x0, a + i, sizeof x0);
+          std::memcpy(&x1, a + i + 8, sizeof x1);
+          std::memcpy(&y0, b + n - 8 - i, sizeof y0);
+          std::memcpy(&y1, b + n - 16 - i, sizeof y1);
+          y0 = _mm256_permutevar8x32_epi32(y0, reverse);
+          y1 = _mm256_permutevar8x32_epi32(y1, reverse);
+          acc0 = _mm256_add_epi32(acc0, _mm256_mullo_epi32(x0, y0));
+          acc1 = _mm256_add_epi32(acc1, _mm256_mullo_epi32(x1, y1));
+        }
+        std::uint32_t lanes[8];
+        std::memcpy(lanes, &acc0, sizeof lanes);
+        std::uint32_t s = 0;
+        for (auto x : lanes)
+          s += x;
+        std::memcpy(lanes, &acc1, sizeof lanes);
+        for (auto x : lanes)
+          s += x;
+        return static_cast<std::int32_t>(
+            s + static_cast<std::uint32_t>(reversed_dot<std::int32_t>(a + i, b, n - i)));
+      }
+#elif defined(__SSE2__)
+      inline double reversed_dot(double const *a, double const *b, std::size_t n)
+      {
+        __m128d acc0 = _mm_setzero_pd();
+        __m128d acc1 = _mm_setzero_pd();
+        std::size_t i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+          __m128d y0 = _mm_loadu_pd(b + n - 2 - i);
+          __m128d y1 = _mm_loadu_pd(b + n - 4 - i);
+          y0 = _mm_shuffle_pd(y0, y0, 1);
+          y1 = _mm_shuffle_pd(y1, y1, 1);
+          acc0 = _mm_add_pd(acc0, _mm_mul_pd(_mm_loadu_pd(a + i), y0));
+          acc1 = _mm_add_pd(acc1, _mm_mul_pd(_mm_loadu_pd(a + i + 2), y1));
+        }
+        double lanes[2];
+        _mm_storeu_pd(lanes, _mm_add_pd(acc0, acc1));
+        return (lanes[0] + lanes[1]) + reversed_dot<double>(a + i, b, n - i);
+      }
+
+      inline float reversed_dot(float const *a, float const *b, std::size_t n)
+      {
+        __m128 acc0 = _mm_setzero_ps();
+        __m128 acc1 = _mm_setzero_ps();
+        std::size_t i = 0;
+        for (; i + 8 <= n; i += 8)
+        {
+          __m128 y0 = _mm_loadu_ps(b + n - 4 - i);
+          __m128 y1 = _mm_loadu_ps(b + n - 8 - i);
+          y0 = _mm_shuffle_ps(y0, y0, _MM_SHUFFLE(0, 1, 2, 3));
+          y1 = _mm_shuffle_ps(y1, y1, _MM_SHUFFLE(0, 1, 2, 3));
+          acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(a + i), y0));
+          acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(a + i + 4), y1));
+        }
+        float lanes[4];
+        _mm_storeu_ps(lanes, _mm_add_ps(acc0, acc1));
+        return ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3]))
+          + reversed_dot<float>(a + i, b, n - i);
+      }
+
+      // SSE2 has no 32-bit mullo: the even and odd lanes are multiplied
+      // separately into 64 bits and their low halves put back together
+      inline __m128i mullo_epi32(__m128i x, __m128i y)
+      {
+        __m128i even = _mm_mul_epu32(x, y);
+        __m128i odd = _mm_mul_epu32(_mm_srli_epi64(x, 32), _mm_srli_epi64(y, 32));
+        return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                                  _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+      }
+
+      // products and sums wrap, as they do for the scalar loop in practice
+      inline std::int32_t reversed_dot(std::int32_t const *a, std::int32_t const *b,
+                                       std::size_t n)
+      {
+        __m128i acc0 = _mm_setzero_si128();
+        __m128i acc1 = _mm_setzero_si128();
+        std::size_t i = 0;
+        for (; i + 8 <= n; i += 8)
+        {
+          __m128i x0, x1, y0, y1;
+          std::memcpy(&x0, a + i, sizeof x0);
+          std::memcpy(&x1, a + i + 4, sizeof x1);
+          std::memcpy(&y0, b + n - 4 - i, sizeof y0);
+          std::memcpy(&y1, b + n - 8 - i, sizeof y1);
+          y0 = _mm_shuffle_epi32(y0, _MM_SHUFFLE(0, 1, 2, 3));
+          y1 = _mm_shuffle_epi32(y1, _MM_SHUFFLE(0, 1, 2, 3));
+          acc0 = _mm_add_epi32(acc0, mullo_epi32(x0, y0));
+          acc1 = _mm_add_epi32(acc1, mullo_epi32(x1, y1));
+        }
+        std::uint32_t lanes[4];
+        std::memcpy(lanes, &acc0, sizeof lanes);
+        std::uint32_t s = 0;
+        for (auto x : lanes)
+          s += x;
+        std::memcpy(lanes, &acc1, sizeof lanes);
+        for (auto x : lanes)
+          s += x;
+        return static_cast<std::int32_t>(
+            s + static_cast<std::uint32_t>(reversed_dot<std::int32_t>(a + i, b, n - i)));
+      }
+#endif
+
+      // out[j] = c[0] + c[1].xs[j] + ... + c[n-1].xs[j]^(n-1), by Horner's
+      // rule run on a block of points at once. One point's chain of
+      // multiply-adds is serial, but the points' chains are independent,
+      // so they fill the lanes; each result is exactly the scalar one.
+      template <typename T>
+      void horner_many(T const *c, std::size_t n, T const *xs, std::size_t m,
+                       T *out)
+      {
+        constexpr std::size_t lanes = 8;
+        if (n == 0)
+        {
+          for (std::size_t j = 0; j < m; ++j)
+            out[j] = T{};
+          return;
+        }
+        std::size_t j = 0;
+        for (; j + lanes <= m; j += lanes)
+        {
+          T acc[lanes];
+          for (std::size_t l = 0; l < lanes; ++l)
+            acc[l] = c[n - 1];
+          for (std::size_t i = n - 1; i > 0; --i)
+            for (std::size_t l = 0; l < lanes; ++l)
+              acc[l] = acc[l] * xs[j + l] + c[i - 1];
+          for (std::size_t l = 0; l < lanes; ++l)
+            out[j + l] = acc[l];
+        }
+        for (; j < m; ++j)
+        {
+          T acc = c[n - 1];
+          for (std::size_t i = n - 1; i > 0; --i)
+            acc = acc * xs[j] + c[i - 1];
+          out[j] = acc;
+        }
+      }
+
+#if defined(__AVX2__)
+      inline void horner_many(double const *c, std::size_t n, double const *xs,
+                              std::size_t m, double *out)
+      {
+        std::size_t j = 0;
+        for (; n > 0 && j + 8 <= m; j += 8)
+        {
+          __m256d x0 = _mm256_loadu_pd(xs + j);
+          __m256d x1 = _mm256_loadu_pd(xs + j + 4);
+          __m256d acc0 = _mm256_set1_pd(c[n - 1]);
+          __m256d acc1 = acc0;
+          for (std::size_t i = n - 1; i > 0; --i)
+          {
+            __m256d ci = _mm256_set1_pd(c[i - 1]);
+            acc0 = _mm256_add_pd(_mm256_mul_pd(acc0, x0), ci);
+            acc1 = _mm256_add_pd(_mm256_mul_pd(acc1, x1), ci);
+          }
+          _mm256_storeu_pd(out + j, acc0);
+          _mm256_storeu_pd(out + j + 4, acc1);
+        }
+        horner_many<double>(c, n, xs + j, m - j, out + j);
+      }
+
+      inline void horner_many(float const *c, std::size_t n, float const *xs,
+                              std::size_t m, float *out)
+      {
+        std::size_t j = 0;
+        for (; n > 0 && j + 16 <= m; j += 16)
+        {
+          __m256 x0 = _mm256_loadu_ps(xs + j);
+          __m256 x1 = _mm256_loadu_ps(xs + j + 8);
+          __m256 acc0 = _mm256_set1_ps(c[n - 1]);
+          __m256 acc1 = acc0;
+          for (std::size_t i = n - 1; i > 0; --i)
+          {
+            __m256 ci = _mm256_set1_ps(c[i - 1]);
+            acc0 = _mm256_add_ps(_mm256_mul_ps(acc0, x0), ci);
+            acc1 = _mm256_add_ps(_mm256_mul_ps(acc1, x1), ci);
+          }
+          _mm256_storeu_ps(out + j, acc0);
+          _mm256_storeu_ps(out + j + 8, acc1);
+        }
+        horner_many<float>(c, n, xs + j, m - j, out + j);
+      }
+#elif defined(__SSE2__)
+      inline void horner_many(double const *c, std::size_t n, double const *xs,
+                              std::size_t m, double *out)
+      {
+        std::size_t j = 0;
+        for (; n > 0 && j + 4 <= m; j += 4)
+        {
+          __m128d x0 = _mm_loadu_pd(xs + j);
+          __m128d x1 = _mm_loadu_pd(xs + j + 2);
+          __m128d acc0 = _mm_set1_pd(c[n - 1]);
+          __m128d acc1 = acc0;
+          for (std::size_t i = n - 1; i > 0; --i)
+          {
+            __m128d ci = _mm_set1_pd(c[i - 1]);
+            acc0 = _mm_add_pd(_mm_mul_pd(acc0, x0), ci);
+            acc1 = _mm_add_pd(_mm_mul_pd(acc1, x1), ci);
+          }
+          _mm_storeu_pd(out + j, acc0);
+          _mm_storeu_pd(out + j + 2, acc1);
+        }
+        horner_many<double>(c, n, xs + j, m - j, out + j);
+      }
+
+      inline void horner_many(float const *c, std::size_t n, float const *xs,
+                              std::size_t m, float *out)
+      {
+        std::size_t j = 0;
+        for (; n > 0 && j + 8 <= m; j += 8)
+        {
+          __m128 x0 = _mm_loadu_ps(xs + j);
+          __m128 x1 = _mm_loadu_ps(xs + j + 4);
+          __m128 acc0 = _mm_set1_ps(c[n - 1]);
+          __m128 acc1 = acc0;
+          for (std::size_t i = n - 1; i > 0; --i)
+          {
+            __m128 ci = _mm_set1_ps(c[i - 1]);
+            acc0 = _mm_add_ps(_mm_mul_ps(acc0, x0), ci);
+            acc1 = _mm_add_ps(_mm_mul_ps(acc1, x1), ci);
+          }
+          _mm_storeu_ps(out + j, acc0);
+          _mm_storeu_ps(out + j + 4, acc1);
+        }
+        horner_many<float>(c, n, xs + j, m - j, out + j);
+      }
+#endif
+
+      // c[0] + c[1].x + ... + c[n-1].x^(n-1) by Estrin's scheme: pairs of
+      // coefficients are joined with x, pairs of those with x^2 and so on,
+      // a tree of depth log n in place of Horner's chain of n steps. No
+      // power of x past x^(n-1) is formed, so integers overflow only where
+      // Horner's rule would.
+      template <typename T>
+      T estrin(T const *c, std::size_t n, T x)
+      {
+        if (n == 0)
+          return T{};
+        std::vector<T> v(c, c + n);
+        while (v.size() > 1)
+        {
+          std::size_t half = v.size() / 2;
+          for (std::size_t i = 0; i < half; ++i)
+            v[i] = v[2 * i] + v[2 * i + 1] * x;
+          if (v.size() % 2 != 0)
+            v[half] = v.back();
+          v.resize(v.size() - half);
+          if (v.size() > 1)
+            x = x * x;
+        }
+        return v[0];
+      }
+
+      // out[i] = carry + in[0] + ... + in[i]; out may be in
+      template <typename T>
+      void inclusive_scan(T const *in, std::size_t n, T carry, T *out)
+      {
+        for (std::size_t i = 0; i < n; ++i)
+          out[i] = carry = static_cast<T>(carry + in[i]);
+      }
+
+#if defined(__SSE2__)
+      // Each block of four is scanned in two shifted adds. Integer sums
+      // are associative, so this is exactly the sequential scan (wrapping
+      // on overflow); floating point would round differently.
+      inline void inclusive_scan(std::int32_t const *in, std::size_t n,
+                                 std::int32_t carry, std::int32_t *out)
+      {
+        __m128i c = _mm_set1_epi32(carry);
+        std::size_t i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+          __m128i x;
+          std::memcpy(&x, in + i, sizeof x);
+          x = _mm_add_epi32(x, _mm_slli_si128(x, 4));
+          x = _mm_add_epi32(x, _mm_slli_si128(x, 8));
+          x = _mm_add_epi32(x, c);
+          std::memcpy(out + i, &x, sizeof x);
+          c = _mm_shuffle_epi32(x, 0xff);
+        }
+        auto s = static_cast<std::uint32_t>(_mm_cvtsi128_si32(c));
+        for (; i < n; ++i)
+        {
+          s += static_cast<std::uint32_t>(in[i]);
+          out[i] = static_cast<std::int32_t>(s);
+        }
+      }
+#endif
+    } // namespace detail
+  }  // inline namespace v3
+} // namespace ranges
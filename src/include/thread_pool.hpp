@@ -0,0 +1,131 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ranges
+{
+  inline namespace v3
+  {
+    // A fixed set of threads that share out one job at a time. A job is a
+    // number of independent tasks; threads take the next task as they
+    // finish one, so uneven tasks balance themselves.
+    struct thread_pool
+    {
+    private:
+      std::vector<std::thread> threads_;
+      std::mutex run_mutex_;
+      std::mutex mutex_;
+      std::condition_variable start_;
+      std::condition_variable done_;
+      std::function<void(std::size_t)> task_;
+      std::size_t tasks_;
+      std::atomic<std::size_t> next_;
+      std::size_t running_;
+      std::size_t generation_;
+      std::exception_ptr error_;
+      bool stop_;
+
+      void drain()
+      {
+        for (std::size_t i; (i = next_.fetch_add(1)) < tasks_;)
+        {
+          try
+          {
+            task_(i);
+          }
+          catch (...)
+          {
+            std::lock_guard<std::mutex> lock{mutex_};
+            if (!error_)
+              error_ = std::current_exception();
+          }
+        }
+      }
+
+      void work()
+      {
+        std::size_t seen = 0;
+        for (;;)
+        {
+          {
+            std::unique_lock<std::mutex> lock{mutex_};
+            start_.wait(lock, [&] { return stop_ || generation_ != seen; });
+            if (stop_)
+              return;
+            seen = generation_;
+          }
+          drain();
+          std::lock_guard<std::mutex> lock{mutex_};
+          if (--running_ == 0)
+            done_.notify_one();
+        }
+      }
+
+    public:
+      // the calling thread counts as one of the threads
+      explicit thread_pool(std::size_t threads = std::thread::hardware_concurrency())
+        : tasks_{0}
+        , next_{0}
+        , running_{0}
+        , generation_{0}
+        , stop_{false}
+      {
+        for (std::size_t i = 1; i < threads; ++i)
+          threads_.emplace_back([this] { work(); });
+      }
+      thread_pool(thread_pool const &) = delete;
+      thread_pool &operator=(thread_pool const &) = delete;
+      ~thread_pool()
+      {
+        {
+          std::lock_guard<std::mutex> lock{mutex_};
+          stop_ = true;
+        }
+        start_.notify_all();
+        for (auto &t : threads_)
+          t.join();
+      }
+
+      std::size_t size() const
+      {
+        return threads_.size() + 1;
+      }
+
+      // Calls f(i) for every i in [0, tasks) and returns when all are done,
+      // rethrowing the first exception any of them threw. Tasks must not
+      // run jobs on the same pool.
+      template <typename F>
+      void run(std::size_t tasks, F f)
+      {
+        std::lock_guard<std::mutex> serial{run_mutex_};
+        {
+          std::lock_guard<std::mutex> lock{mutex_};
+          task_ = std::ref(f);
+          tasks_ = tasks;
+          next_.store(0);
+          running_ = threads_.size();
+          error_ = nullptr;
+          ++generation_;
+        }
+        start_.notify_all();
+        drain();
+        std::exception_ptr error;
+        {
+          std::unique_lock<std::mutex> lock{mutex_};
+          done_.wait(lock, [&] { return running_ == 0; });
+          task_ = nullptr;
+          std::swap(error, error_);
+        }
+        if (error)
+          std::rethrow_exception(error);
+      }
+    };
+  }  // inline namespace v3
+} // namespace ranges
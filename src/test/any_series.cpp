@@ -0,0 +1,74 @@
+#include "any_series.hpp"
+#include "power_series.hpp"
+
+#include <range/v3/all.hpp>
+
+#include <testinator.h>
+
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace ranges;
+
+// -----------------------------------------------------------------------------
+// Tests for any_series
+
+DEF_TEST(FromVector, AnySeries)
+{
+  vector<int> v(150);
+  for (size_t i = 0; i < v.size(); ++i)
+    v[i] = static_cast<int>(i);
+  any_series<int> s = v;
+  EXPECT(ranges::equal(s, v));
+  EXPECT(ranges::distance(s) == 150);
+  return true;
+}
+
+DEF_TEST(FromExpression, AnySeries)
+{
+  vector<int> v1{1, 2, 3};
+  vector<int> v2{1, 1};
+  any_series<int> s = power_series::add(power_series::multiply(v1, v2),
+                                        view::single(1));
+  EXPECT(power_series::to_string(s) == "2 + 3x + 5x^2 + 3x^3");
+  return true;
+}
+
+DEF_TEST(ComposedAtRunTime, AnySeries)
+{
+  // 1/(1 - x)^2, multiplied by 1 + x three times over
+  any_series<int> s = view::iota(1);
+  for (int k = 0; k < 3; ++k)
+    s = power_series::add(s, view::concat(view::single(0), s));
+  vector<int> expected{1, 5, 12, 20, 28, 36};
+  EXPECT(ranges::equal(view::take(s, 6), expected));
+  return true;
+}
+
+DEF_TEST(Container, AnySeries)
+{
+  vector<int> v{1, 2, 3};
+  vector<any_series<int>> series;
+  series.push_back(v);
+  series.push_back(view::repeat(1));
+  series.push_back(view::iota(0));
+  auto s = power_series::sum(series, 5);
+  EXPECT(ranges::equal(s, vector<int>{2, 4, 6, 4, 5}));
+  return true;
+}
+
+DEF_TEST(CursorsIndependent, AnySeries)
+{
+  any_series<int> s = view::iota(0);
+  auto i = ranges::begin(s);
+  ranges::advance(i, 100);
+  auto j = i;
+  ranges::advance(i, 50);
+  EXPECT(*i == 150);
+  EXPECT(*j == 100);
+  ++j;
+  EXPECT(*j == 101);
+  EXPECT(*ranges::begin(s) == 0);
+  return true;
+}
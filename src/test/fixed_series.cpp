@@ -0,0 +1,78 @@
+#include "fixed_series.hpp"
+#include "power_series.hpp"
+
+#include <range/v3/all.hpp>
+
+#include <testinator.h>
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace ranges;
+
+// -----------------------------------------------------------------------------
+// Tests for fixed_series
+
+namespace
+{
+  constexpr power_series::fixed_series<int, 3> a{1, 2, 3};
+  constexpr power_series::fixed_series<int, 2> b{1, -1};
+
+  // exp(x) to x^12, by integrating 1 twelve times over
+  constexpr auto exp_table()
+  {
+    power_series::fixed_series<double, 13> e{1};
+    for (int k = 0; k < 12; ++k)
+      e = power_series::truncate<13>(
+          power_series::add(power_series::fixed_series<double, 1>{1},
+                            power_series::integrate(e)));
+    return e;
+  }
+  constexpr auto exp12 = exp_table();
+}
+
+DEF_TEST(CompileTime, FixedSeries)
+{
+  constexpr auto s = power_series::add(a, b);
+  static_assert(s.size() == 3 && s[0] == 2 && s[1] == 1 && s[2] == 3, "add");
+  constexpr auto d = power_series::subtract(a, b);
+  static_assert(d[0] == 0 && d[1] == 3, "subtract");
+  constexpr auto p = power_series::multiply(a, b);
+  static_assert(p.size() == 4 && p[1] == 1 && p[3] == -3, "multiply");
+  constexpr auto n = power_series::negate(b);
+  static_assert(n[1] == 1, "negate");
+  constexpr auto dd = power_series::differentiate(a);
+  static_assert(dd.size() == 2 && dd[1] == 6, "differentiate");
+  constexpr auto i = power_series::integrate(b);
+  static_assert(i.size() == 3 && i[2] == -0.5f, "integrate");
+  static_assert(a(2) == 17, "evaluate");
+  EXPECT(power_series::to_string(p) == "1 + x + x^2 - 3x^3");
+  return true;
+}
+
+DEF_TEST(Taylor, FixedSeries)
+{
+  static_assert(exp12[2] == 0.5, "exp");
+  EXPECT(std::abs(exp12(0.5) - std::exp(0.5)) < 1e-12);
+  // exp(x + x^2) = 1 + x + 3/2 x^2 + 7/6 x^3 + ...
+  constexpr power_series::fixed_series<double, 3> g{0, 1, 1};
+  constexpr auto c = power_series::compose(exp12, g);
+  static_assert(c[2] == 1.5, "compose");
+  vector<double> vg{0, 1, 1};
+  auto expected = power_series::compose(exp12, vg, 13);
+  for (size_t k = 0; k < 13; ++k)
+    EXPECT(std::abs(c[k] - expected[k]) < 1e-12);
+  return true;
+}
+
+DEF_TEST(AsRange, FixedSeries)
+{
+  // with other series, a fixed_series is a contiguous range like a vector
+  vector<int> v{1, 1, 1, 1};
+  EXPECT(ranges::equal(power_series::add(a, v), vector<int>{2, 3, 4, 1}));
+  EXPECT(ranges::equal(power_series::multiply(a, v),
+                       vector<int>{1, 3, 6, 6, 5, 3}));
+  return true;
+}
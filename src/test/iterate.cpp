@@ -5,7 +5,10 @@
 
 #include <testinator.h>
 
+#include <array>
+#include <cstdint>
 #include <string>
+#include <vector>
 
 using namespace std;
 using namespace ranges;
@@ -54,6 +57,40 @@ DEF_TEST(Collatz6, Iterate)
   return true;
 }
 
+DEF_TEST(AffineJump, Iterate)
+{
+  // a linear congruential generator, jumped ahead without stepping
+  affine_map<uint32_t> lcg{1664525u, 1013904223u};
+  auto m = view::iterate(lcg, 42u);
+  uint32_t x = 42u;
+  for (int i = 0; i < 100000; ++i)
+    x = lcg(x);
+  EXPECT(ranges::at(m, 100000) == x);
+  auto it = ranges::next(ranges::begin(m), 100000);
+  EXPECT(*it == x);
+  EXPECT(*ranges::prev(it, 99999) == lcg(42u));
+  EXPECT(ranges::next(ranges::begin(m), 100000) - ranges::begin(m) == 100000);
+  // separate blocks of the stream, as separate threads would take them,
+  // against the generator stepped by hand
+  vector<uint32_t> expected;
+  x = 42u;
+  for (int i = 0; i < 50003; ++i, x = lcg(x))
+    if (i >= 50000)
+      expected.push_back(x);
+  EXPECT(ranges::equal(view::take(view::drop(m, 50000), 3), expected));
+  return true;
+}
+
+DEF_TEST(MatrixJump, Iterate)
+{
+  // Fibonacci numbers by their companion matrix
+  matrix_map<int64_t, 2> fib{{{{{1, 1}}, {{1, 0}}}}};
+  auto m = view::iterate(fib, array<int64_t, 2>{{1, 0}});
+  EXPECT(ranges::at(m, 50)[1] == 12586269025);
+  EXPECT(ranges::at(m, 10)[1] == 55);
+  return true;
+}
+
 DEF_TEST(PlusOneN, IterateN)
 {
   auto m = view::iterate_n([] (int x) { return x + 1; }, 0, 5);
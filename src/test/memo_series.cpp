@@ -0,0 +1,98 @@
+#include "memo_series.hpp"
+#include "iterate.hpp"
+#include "power_series.hpp"
+
+#include <range/v3/all.hpp>
+
+#include <testinator.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace ranges;
+
+// -----------------------------------------------------------------------------
+// Tests for memo_series
+
+DEF_TEST(MultiPass, MemoSeries)
+{
+  // iterate is single-pass; its memoized form can be traversed repeatedly
+  auto m = view::memoize(view::iterate([] (int x) { return x * 2; }, 1));
+  auto s1 = ranges::accumulate(view::take(m, 5), 0);
+  auto s2 = ranges::accumulate(view::take(m, 5), 0);
+  EXPECT(s1 == 31);
+  EXPECT(s2 == 31);
+  EXPECT(ranges::at(m, 10) == 1024);
+  return true;
+}
+
+DEF_TEST(ComputedOnce, MemoSeries)
+{
+  int calls = 0;
+  auto m = view::memoize(
+      view::transform(view::iota(0), [&calls] (int x) { ++calls; return x * x; }));
+  auto copy = m;
+  EXPECT(ranges::accumulate(view::take(m, 100), 0) ==
+         ranges::accumulate(view::take(copy, 100), 0));
+  EXPECT(ranges::at(m, 50) == 2500);
+  EXPECT(calls == 100);
+  return true;
+}
+
+DEF_TEST(Finite, MemoSeries)
+{
+  vector<int> v{1, 2, 3};
+  auto m = view::memoize(v);
+  string s = ranges::accumulate(
+      m,
+      string(),
+      [] (string s, int x) {
+        return s + to_string(x);
+      });
+  EXPECT(s == "123");
+  EXPECT(ranges::distance(m) == 3);
+  return true;
+}
+
+DEF_TEST(SharedProduct, MemoSeries)
+{
+  // the inner product is evaluated once, not once per outer coefficient:
+  // coefficient k of ab reads k + 1 coefficients of a, and the outer
+  // product needs ab up to x^2, so a is read 1 + 2 + 3 times. Reading ab
+  // afresh for each coefficient of abc would take 1 + 3 + 6.
+  atomic<int> calls{0};
+  auto a = view::transform(view::iota(1), [&calls] (int x) { ++calls; return x; });
+  auto ab = view::memoize(power_series::multiply(a, view::iota(1)));
+  auto abc = power_series::multiply(ab, view::iota(1));
+  auto it = ranges::begin(abc);
+  EXPECT(*it == 1);
+  ++it;
+  EXPECT(*it == 6);
+  ++it;
+  EXPECT(*it == 21);
+  EXPECT(calls.load() == 6);
+  return true;
+}
+
+DEF_TEST(Threads, MemoSeries)
+{
+  atomic<int> calls{0};
+  auto m = view::memoize(
+      view::transform(view::iota(0), [&calls] (int x) { ++calls; return x; }));
+  vector<thread> threads;
+  atomic<bool> ok{true};
+  for (int t = 0; t < 4; ++t)
+    threads.emplace_back([m, &ok] {
+        long long sum = ranges::accumulate(view::take(m, 10000), 0ll);
+        if (sum != 10000ll * 9999 / 2)
+          ok = false;
+      });
+  for (auto& t : threads)
+    t.join();
+  EXPECT(ok.load());
+  EXPECT(calls.load() == 10000);
+  return true;
+}
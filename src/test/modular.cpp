@@ -0,0 +1,41 @@
+#include "modular.hpp"
+
+#include <testinator.h>
+
+using namespace std;
+
+// -----------------------------------------------------------------------------
+// Tests for modular
+
+using mod7 = power_series::modular<7>;
+
+DEF_TEST(Reduce, Modular)
+{
+  EXPECT(mod7{10}.value() == 3);
+  EXPECT(mod7{-1}.value() == 6);
+  EXPECT(mod7{-7}.value() == 0);
+  return true;
+}
+
+DEF_TEST(Arithmetic, Modular)
+{
+  mod7 a{5};
+  mod7 b{4};
+  EXPECT(a + b == mod7{2});
+  EXPECT(a - b == mod7{1});
+  EXPECT(b - a == mod7{6});
+  EXPECT(a * b == mod7{6});
+  EXPECT(-a == mod7{2});
+  return true;
+}
+
+DEF_TEST(Inverse, Modular)
+{
+  for (int i = 1; i < 7; ++i)
+  {
+    mod7 a{i};
+    EXPECT(a * a.inverse() == mod7{1});
+    EXPECT(a / a == mod7{1});
+  }
+  return true;
+}
@@ -4,6 +4,7 @@
 
 #include <testinator.h>
 
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -135,3 +136,47 @@ DEF_TEST(LargerSecondReverse, MonoidalZip)
   EXPECT(s == "5d4c3b2a1");
   return true;
 }
+
+DEF_TEST(ManyRanges, MonoidalZip)
+{
+  vector<string> v1{"a", "b"};
+  vector<string> v2{"1", "2", "3", "4"};
+  vector<string> v3{"x", "y", "z"};
+
+  auto m = view::monoidal_zip(
+      [] (const string& a, const string& b) {
+        return a + b;
+      },
+      v1, v2, v3);
+  EXPECT(ranges::distance(m) == 4);
+  string s = ranges::accumulate(
+      m,
+      string(),
+      [] (string s, const string& x) {
+        return s + x;
+      });
+  EXPECT(s == "a1xb2y3z4");
+  return true;
+}
+
+DEF_TEST(RandomAccess, MonoidalZip)
+{
+  vector<int> v1{1, 2, 3, 4, 5, 6};
+  vector<int> v2{10, 20, 30};
+
+  auto m = view::monoidal_zip(std::plus<>(), v1, v2);
+  EXPECT(ranges::at(m, 1) == 22);
+  EXPECT(ranges::at(m, 4) == 5);
+  auto first = ranges::begin(m);
+  auto last = ranges::end(m);
+  EXPECT(last - first == 6);
+  EXPECT(first - last == -6);
+  EXPECT(*(last - 4) == 33);
+  EXPECT(*(first + 5 - 3) == 33);
+  EXPECT(ranges::equal(view::drop(m, 2), vector<int>{33, 4, 5, 6}));
+
+  auto n = view::monoidal_zip(std::plus<>(), v2, view::iota(0));
+  EXPECT(ranges::at(n, 2) == 32);
+  EXPECT(ranges::at(n, 1000) == 1000);
+  return true;
+}
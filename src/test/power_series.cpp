@@ -1,9 +1,14 @@
 #include "power_series.hpp"
+#include "modular.hpp"
 
 #include <range/v3/all.hpp>
 
 #include <testinator.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
 #include <string>
 #include <vector>
 
@@ -35,6 +40,85 @@ DEF_TEST(AddSeriesInfinite, PowerSeries)
   return true;
 }
 
+DEF_TEST(AddSeriesUnequal, PowerSeries)
+{
+  vector<int> v1{1, 2, 3};
+  vector<int> v2{1, 1, 1, 1, 1};
+  EXPECT(power_series::to_string(power_series::add(v1, v2)) ==
+         "2 + 3x + 4x^2 + x^3 + x^4");
+  EXPECT(power_series::to_string(power_series::subtract(v1, v2)) ==
+         "x + 2x^2 - x^3 - x^4");
+  EXPECT(power_series::to_string(power_series::truncate(power_series::add(v1, v2), 2)) ==
+         "2 + 3x");
+  EXPECT(power_series::to_string(power_series::truncate(
+             power_series::truncate(power_series::add(v1, v2), 2), 5)) == "2 + 3x");
+  return true;
+}
+
+DEF_TEST(AddSeriesSnapshot, PowerSeries)
+{
+  // vectors are added when the sum is first read, and not again
+  vector<int> v1{1, 2, 3};
+  vector<int> v2{1, 1, 1};
+  auto a = power_series::add(v1, v2);
+  v1[0] = 10;
+  auto b = a;
+  EXPECT(power_series::to_string(b) == "11 + 3x + 4x^2");
+  v1[0] = 1;
+  EXPECT(power_series::to_string(a) == "11 + 3x + 4x^2");
+  EXPECT(power_series::to_string(power_series::add(v1, v2)) == "2 + 3x + 4x^2");
+  return true;
+}
+
+DEF_TEST(AddInto, PowerSeries)
+{
+  vector<int> v1{1, 2, 3};
+  vector<int> v2{1, 1, 1, 1, 1};
+  vector<int> out(5);
+  EXPECT(power_series::add_into(out, v1, v2) == 5u);
+  EXPECT((out == vector<int>{2, 3, 4, 1, 1}));
+  EXPECT(power_series::subtract_into(out, out, v1) == 5u);
+  EXPECT(out == v2);
+  // other ranges are added one coefficient at a time
+  EXPECT(power_series::add_into(out, view::iota(1, 4), v2) == 5u);
+  EXPECT((out == vector<int>{2, 3, 4, 1, 1}));
+  return true;
+}
+
+DEF_TEST(SumSeries, PowerSeries)
+{
+  vector<int> v1{1, 2, 3};
+  vector<int> v2{1, 1, 1, 1, 1};
+  vector<int> v3{0, 0, 0, 1};
+  string s = power_series::to_string(power_series::sum(v1, v2, v3));
+  EXPECT(s == "2 + 3x + 4x^2 + 2x^3 + x^4");
+  return true;
+}
+
+DEF_TEST(SumSeriesInfinite, PowerSeries)
+{
+  auto a = power_series::sum(view::iota(1), view::iota(1), view::iota(1));
+  string s = power_series::to_string(view::take(a, 3));
+  EXPECT(s == "3 + 6x + 9x^2");
+  return true;
+}
+
+DEF_TEST(SumSeriesRange, PowerSeries)
+{
+  vector<vector<int>> vs;
+  for (int i = 0; i < 300; ++i)
+    vs.push_back(vector<int>(static_cast<size_t>(i % 7 + 1), 1));
+  auto v = power_series::sum(vs);
+  EXPECT(v.size() == 7u);
+  EXPECT(v[0] == 300 && v[6] == 42);
+  // the first n coefficients of a range of infinite series
+  auto w = power_series::sum(view::transform(view::iota(1, 4), [] (int i) {
+        return view::iota(i);
+      }), 3);
+  EXPECT(power_series::to_string(w) == "6 + 9x + 12x^2");
+  return true;
+}
+
 // -----------------------------------------------------------------------------
 // Negation
 
@@ -77,6 +161,15 @@ DEF_TEST(SubtractSeriesInfinite, PowerSeries)
   return true;
 }
 
+DEF_TEST(SubtractSeriesLonger, PowerSeries)
+{
+  // the second series' tail is negated too
+  vector<int> v2{0, 1, 2};
+  auto a = power_series::subtract(view::single(1), v2);
+  EXPECT(ranges::equal(a, vector<int>{1, -1, -2}));
+  return true;
+}
+
 // -----------------------------------------------------------------------------
 // Multiplication
 
@@ -107,6 +200,217 @@ DEF_TEST(MultiplySeriesLargerSecond, PowerSeries)
   return true;
 }
 
+DEF_TEST(MultiplySeriesInfinite, PowerSeries)
+{
+  auto m = ranges::view::iota(1);
+  auto n = ranges::view::iota(1);
+  auto a = power_series::multiply(m, n);
+  string s = power_series::to_string(view::take(a, 3));
+  EXPECT(s == "1 + 4x + 10x^2");
+  return true;
+}
+
+DEF_TEST(MultiplySeriesRelaxed, PowerSeries)
+{
+  auto m = ranges::view::iota(1);
+  auto n = ranges::view::iota(1);
+  auto a = power_series::multiply(m, n, series_mult_strategy::relaxed{});
+  string s = power_series::to_string(view::take(a, 3));
+  EXPECT(s == "1 + 4x + 10x^2");
+  return true;
+}
+
+DEF_TEST(MultiplySeriesLarge, PowerSeries)
+{
+  // (1 + x + ... + x^299)(1 + x + ... + x^199) is well past the schoolbook
+  // cutoff, so this goes through the Karatsuba kernel
+  vector<int> v1(300, 1);
+  vector<int> v2(200, 1);
+  auto a = power_series::multiply(v1, v2);
+  EXPECT(ranges::size(a) == 499u);
+  for (int i = 0; i < 499; ++i)
+  {
+    int expected = std::min(std::min(i + 1, 200), 499 - i);
+    EXPECT(ranges::at(a, i) == expected);
+  }
+  return true;
+}
+
+DEF_TEST(MultiplySeriesStrategies, PowerSeries)
+{
+  vector<int> v1(300);
+  vector<int> v2(200);
+  for (int i = 0; i < 300; ++i)
+    v1[static_cast<size_t>(i)] = i % 7 - 3;
+  for (int i = 0; i < 200; ++i)
+    v2[static_cast<size_t>(i)] = i % 5 - 2;
+  auto naive = power_series::multiply(v1, v2, series_mult_strategy::naive{});
+  auto karatsuba = power_series::multiply(v1, v2, series_mult_strategy::karatsuba{});
+  auto fft = power_series::multiply(v1, v2, series_mult_strategy::fft{});
+  EXPECT(ranges::equal(naive, karatsuba));
+  EXPECT(ranges::equal(naive, fft));
+  return true;
+}
+
+DEF_TEST(MultiplySeriesSnapshot, PowerSeries)
+{
+  // vectors are multiplied when the product is first read, and not again;
+  // the naive strategy reads them as it goes
+  vector<int> v1{1, 1};
+  vector<int> v2{1, 2};
+  auto m = power_series::multiply(v1, v2);
+  auto naive = power_series::multiply(v1, v2, series_mult_strategy::naive{});
+  EXPECT(power_series::to_string(m) == "1 + 3x + 2x^2");
+  v1[1] = 2;
+  EXPECT(power_series::to_string(m) == "1 + 3x + 2x^2");
+  EXPECT(power_series::to_string(naive) == "1 + 4x + 4x^2");
+  return true;
+}
+
+DEF_TEST(MultiplySeriesRandomAccess, PowerSeries)
+{
+  // the lazy cursor jumps straight to a coefficient, in either direction
+  vector<int> v1(300);
+  vector<int> v2(200);
+  for (int i = 0; i < 300; ++i)
+    v1[static_cast<size_t>(i)] = i % 7 - 3;
+  for (int i = 0; i < 200; ++i)
+    v2[static_cast<size_t>(i)] = i % 5 - 2;
+  auto naive = power_series::multiply(v1, v2, series_mult_strategy::naive{});
+  auto karatsuba = power_series::multiply(v1, v2, series_mult_strategy::karatsuba{});
+  for (int k : {0, 1, 150, 199, 200, 250, 299, 300, 450, 498})
+    EXPECT(ranges::at(naive, k) == ranges::at(karatsuba, k));
+  auto first = ranges::begin(naive);
+  auto last = ranges::end(naive);
+  EXPECT(last - first == 499);
+  EXPECT(first - last == -499);
+  EXPECT(*(last - 1) == ranges::at(karatsuba, 498));
+  EXPECT(ranges::equal(view::drop(naive, 260), view::drop(karatsuba, 260)));
+  // an infinite input
+  auto m = power_series::multiply(view::iota(1), v2, series_mult_strategy::naive{});
+  EXPECT(ranges::at(m, 1000) ==
+         ranges::inner_product(view::iota(802, 1002), view::reverse(v2), 0));
+  return true;
+}
+
+DEF_TEST(MultiplySeriesNaiveContiguous, PowerSeries)
+{
+  // the naive strategy on vectors of doubles takes the vectorized inner
+  // product; small dyadic coefficients keep every summation order exact
+  vector<double> v1(100);
+  vector<double> v2(70);
+  for (int i = 0; i < 100; ++i)
+    v1[static_cast<size_t>(i)] = (i % 9 - 4) * 0.5;
+  for (int i = 0; i < 70; ++i)
+    v2[static_cast<size_t>(i)] = (i % 5 - 2) * 0.25;
+  auto naive = power_series::multiply(v1, v2, series_mult_strategy::naive{});
+  auto karatsuba = power_series::multiply(v1, v2, series_mult_strategy::karatsuba{});
+  EXPECT(ranges::equal(naive, karatsuba));
+  return true;
+}
+
+DEF_TEST(MultiplySeriesParallel, PowerSeries)
+{
+  vector<int> v1(300);
+  vector<int> v2(200);
+  for (int i = 0; i < 300; ++i)
+    v1[static_cast<size_t>(i)] = i % 7 - 3;
+  for (int i = 0; i < 200; ++i)
+    v2[static_cast<size_t>(i)] = i % 5 - 2;
+  thread_pool pool{4};
+  auto p = power_series::multiply_parallel(v1, v2, pool);
+  EXPECT(ranges::equal(p, power_series::multiply(v1, v2)));
+  EXPECT(power_series::multiply_parallel(vector<int>{}, v2, pool).empty());
+  return true;
+}
+
+DEF_TEST(MultiplySeriesModular, PowerSeries)
+{
+  using mod = power_series::modular<998244353>;
+  vector<mod> v1(500, mod{-1});
+  vector<mod> v2(500, mod{2});
+  auto m = power_series::multiply(v1, v2, series_mult_strategy::fft{});
+  EXPECT(ranges::at(m, 0) == mod{-2});
+  EXPECT(ranges::at(m, 499) == mod{-1000});
+  EXPECT(ranges::at(m, 998) == mod{-2});
+  return true;
+}
+
+DEF_TEST(MultiplySeriesWideIntegers, PowerSeries)
+{
+  // past the integer transform cutoff, 64-bit coefficients wrap as they do
+  // under Karatsuba rather than overflowing the three-prime NTT
+  size_t n = 32768;
+  vector<uint64_t> u1(n), u2(n);
+  vector<int64_t> s1(n), s2(n);
+  uint64_t x = 88172645463325252u;
+  for (size_t i = 0; i < n; ++i)
+  {
+    x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+    u1[i] = x;
+    s1[i] = (i % 2 ? -1 : 1) * ((int64_t{1} << 40) + static_cast<int64_t>(i));
+    x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+    u2[i] = x;
+    s2[i] = static_cast<int64_t>(i % 7) - 3;
+  }
+  auto u = power_series::multiply(u1, u2);
+  auto uf = power_series::multiply(u1, u2, series_mult_strategy::fft{});
+  auto s = power_series::multiply(s1, s2);
+  for (size_t k : {size_t{0}, size_t{1}, size_t{1000}, n - 1, n, 2 * n - 2})
+  {
+    uint64_t uk = 0;
+    int64_t sk = 0;
+    for (size_t i = k < n ? 0 : k - n + 1; i <= k && i < n; ++i)
+    {
+      uk += u1[i] * u2[k - i];
+      sk += s1[i] * s2[k - i];
+    }
+    EXPECT(ranges::at(u, static_cast<int>(k)) == uk);
+    EXPECT(ranges::at(uf, static_cast<int>(k)) == uk);
+    EXPECT(ranges::at(s, static_cast<int>(k)) == sk);
+  }
+  return true;
+}
+
+DEF_TEST(MultiplySeriesTruncated, PowerSeries)
+{
+  vector<int> v1{1, 2, 3, 4, 5};
+  vector<int> v2{1, 2, 3, 4, 5};
+  string s = power_series::to_string(power_series::multiply_truncated(v1, v2, 4));
+  EXPECT(s == "1 + 4x + 10x^2 + 20x^3");
+  // past the end of the product the coefficients are zero
+  auto t = power_series::multiply_truncated(v1, v2, 12);
+  EXPECT(t.size() == 12u);
+  EXPECT(t[8] == 25 && t[9] == 0 && t[11] == 0);
+  return true;
+}
+
+DEF_TEST(MultiplySeriesTruncatedInfinite, PowerSeries)
+{
+  auto m = ranges::view::iota(1);
+  auto n = ranges::view::iota(1);
+  string s = power_series::to_string(power_series::multiply_truncated(m, n, 3));
+  EXPECT(s == "1 + 4x + 10x^2");
+  return true;
+}
+
+DEF_TEST(MultiplySeriesTruncatedLarge, PowerSeries)
+{
+  // long enough for the short product kernels to split
+  vector<int> v1(3000);
+  vector<int> v2(2000);
+  for (int i = 0; i < 3000; ++i)
+    v1[static_cast<size_t>(i)] = i % 7 - 3;
+  for (int i = 0; i < 2000; ++i)
+    v2[static_cast<size_t>(i)] = i % 5 - 2;
+  auto full = power_series::multiply(v1, v2);
+  auto low = power_series::multiply_truncated(v1, v2, 2500);
+  EXPECT(ranges::equal(low, view::take(full, 2500)));
+  auto middle = power_series::multiply_middle(v1, v2, 1000, 4000);
+  EXPECT(ranges::equal(middle, view::take(view::drop(full, 1000), 3000)));
+  return true;
+}
+
 DEF_TEST(MultiplySeriesReversible, PowerSeries)
 {
   vector<int> v1{1, 1};
@@ -116,6 +420,198 @@ DEF_TEST(MultiplySeriesReversible, PowerSeries)
   return true;
 }
 
+// -----------------------------------------------------------------------------
+// Division
+
+DEF_TEST(ReciprocalSeries, PowerSeries)
+{
+  vector<int> v1{1, -1};
+  string s = power_series::to_string(power_series::reciprocal(v1, 5));
+  EXPECT(s == "1 + x + x^2 + x^3 + x^4");
+  return true;
+}
+
+DEF_TEST(ReciprocalSeriesInfinite, PowerSeries)
+{
+  // 1 + 2x + 3x^2 + ... = 1/(1 - x)^2
+  auto n = ranges::view::iota(1);
+  string s = power_series::to_string(power_series::reciprocal(n, 5));
+  EXPECT(s == "1 - 2x + x^2");
+  return true;
+}
+
+DEF_TEST(ReciprocalSeriesLarge, PowerSeries)
+{
+  vector<int> v1{1, -2, 1};
+  auto r = power_series::reciprocal(v1, 300);
+  EXPECT(r.size() == 300u);
+  for (int i = 0; i < 300; ++i)
+    EXPECT(r[static_cast<size_t>(i)] == i + 1);
+  return true;
+}
+
+DEF_TEST(DivideSeries, PowerSeries)
+{
+  vector<int> v1{1};
+  vector<int> v2{1, -1, -1};
+  string s = power_series::to_string(power_series::divide(v1, v2, 8));
+  EXPECT(s == "1 + x + 2x^2 + 3x^3 + 5x^4 + 8x^5 + 13x^6 + 21x^7");
+  return true;
+}
+
+DEF_TEST(ReciprocalSeriesLazy, PowerSeries)
+{
+  vector<int> v1{1, -1};
+  auto r = power_series::reciprocal(v1);
+  string s = power_series::to_string(view::take(r, 5));
+  EXPECT(s == "1 + x + x^2 + x^3 + x^4");
+  return true;
+}
+
+DEF_TEST(DivideSeriesLazy, PowerSeries)
+{
+  vector<int> v1{1};
+  vector<int> v2{1, -1, -1};
+  auto d = power_series::divide(v1, v2);
+  string s = power_series::to_string(view::take(d, 8));
+  EXPECT(s == "1 + x + 2x^2 + 3x^3 + 5x^4 + 8x^5 + 13x^6 + 21x^7");
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+// Elementary functions
+
+DEF_TEST(ExpSeries, PowerSeries)
+{
+  vector<int> v1{0, 1};
+  auto e = power_series::exp(v1, 6);
+  float factorial = 1.f;
+  for (int i = 0; i < 6; ++i)
+  {
+    if (i > 0) factorial *= static_cast<float>(i);
+    EXPECT(std::abs(e[static_cast<size_t>(i)] - 1.f/factorial) < 1e-6f);
+  }
+  return true;
+}
+
+DEF_TEST(LogSeries, PowerSeries)
+{
+  // log 1/(1 - x) = x + x^2/2 + x^3/3 + ...
+  vector<double> v1(8, 1.0);
+  auto l = power_series::log(v1, 8);
+  EXPECT(l[0] == 0.0);
+  for (int i = 1; i < 8; ++i)
+    EXPECT(std::abs(l[static_cast<size_t>(i)] - 1.0/i) < 1e-12);
+  return true;
+}
+
+DEF_TEST(PowSeries, PowerSeries)
+{
+  vector<double> v1{1, 1};
+  auto p = power_series::pow(v1, 3, 5);
+  vector<double> expected{1, 3, 3, 1, 0};
+  for (size_t i = 0; i < 5; ++i)
+    EXPECT(std::abs(p[i] - expected[i]) < 1e-12);
+  return true;
+}
+
+DEF_TEST(PowSeriesLeadingZeros, PowerSeries)
+{
+  using mod = power_series::modular<998244353>;
+  vector<mod> v1{0, 1, 1};
+  auto p = power_series::pow(v1, 2, 6);
+  EXPECT(p == (vector<mod>{0, 0, 1, 2, 1, 0}));
+  return true;
+}
+
+DEF_TEST(PowSeriesNegative, PowerSeries)
+{
+  // (1 + x)^-2 = 1 - 2x + 3x^2 - 4x^3 + ...
+  using mod = power_series::modular<998244353>;
+  vector<mod> v1{1, 1};
+  auto p = power_series::pow(v1, -2, 4);
+  EXPECT(p == (vector<mod>{1, -2, 3, -4}));
+  EXPECT(power_series::pow(v1, -1, 0).empty());
+  return true;
+}
+
+DEF_TEST(SqrtSeries, PowerSeries)
+{
+  vector<double> v1{4, 4, 1};
+  auto r = power_series::sqrt(v1, 5);
+  vector<double> expected{2, 1, 0, 0, 0};
+  for (size_t i = 0; i < 5; ++i)
+    EXPECT(std::abs(r[i] - expected[i]) < 1e-12);
+  return true;
+}
+
+DEF_TEST(ExpLogSeriesLarge, PowerSeries)
+{
+  // exact arithmetic, long enough to take the transform kernels
+  using mod = power_series::modular<998244353>;
+  vector<mod> v1(1000);
+  for (int i = 1; i < 1000; ++i)
+    v1[static_cast<size_t>(i)] = i * i % 17;
+  auto e = power_series::exp(v1, 1000);
+  EXPECT(power_series::log(e, 1000) == v1);
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+// Composition
+
+DEF_TEST(ComposeSeries, PowerSeries)
+{
+  // 1/(1 - y) with y = x + x^2 generates the Fibonacci numbers
+  vector<int> v1(8, 1);
+  vector<int> v2{0, 1, 1};
+  string s = power_series::to_string(power_series::compose(v1, v2, 8));
+  EXPECT(s == "1 + x + 2x^2 + 3x^3 + 5x^4 + 8x^5 + 13x^6 + 21x^7");
+  return true;
+}
+
+DEF_TEST(ComposeSeriesInfinite, PowerSeries)
+{
+  // 1 + 2y + 3y^2 + ... = 1/(1 - y)^2, and with y = -x that's 1/(1 + x)^2
+  auto n = ranges::view::iota(1);
+  vector<int> v2{0, -1};
+  string s = power_series::to_string(power_series::compose(n, v2, 5));
+  EXPECT(s == "1 - 2x + 3x^2 - 4x^3 + 5x^4");
+  return true;
+}
+
+DEF_TEST(RevertSeries, PowerSeries)
+{
+  // the inverse of x - x^2 generates the Catalan numbers
+  vector<int> v1{0, 1, -1};
+  string s = power_series::to_string(power_series::revert(v1, 7));
+  EXPECT(s == "x + x^2 + 2x^3 + 5x^4 + 14x^5 + 42x^6");
+  return true;
+}
+
+DEF_TEST(RevertSeriesShort, PowerSeries)
+{
+  vector<int> v1{0, 1, -1};
+  EXPECT(power_series::revert(v1, 0).empty());
+  EXPECT(power_series::revert(v1, 1) == vector<int>{0});
+  EXPECT(power_series::revert(v1, 2) == (vector<int>{0, 1}));
+  return true;
+}
+
+DEF_TEST(RevertSeriesLarge, PowerSeries)
+{
+  using mod = power_series::modular<998244353>;
+  vector<mod> v1(500);
+  for (int i = 1; i < 500; ++i)
+    v1[static_cast<size_t>(i)] = i * i % 13 + 1;
+  auto g = power_series::revert(v1, 500);
+  auto x = power_series::compose(v1, g, 500);
+  EXPECT(x[1] == mod{1});
+  x[1] = 0;
+  EXPECT(x == vector<mod>(500));
+  return true;
+}
+
 // -----------------------------------------------------------------------------
 // Differentiation
 
@@ -141,6 +637,225 @@ DEF_TEST(IntegrateSeries, PowerSeries)
   return true;
 }
 
+// -----------------------------------------------------------------------------
+// Truncation
+
+DEF_TEST(TruncateSeries, PowerSeries)
+{
+  vector<int> v1{1, 2, 3, 4, 5};
+  vector<int> v2{1, 2, 3, 4, 5};
+  vector<int> v3{1, 1, 1, 1, 1};
+  auto e = power_series::add(power_series::multiply(v1, v2),
+                             power_series::differentiate(v3));
+  string s = power_series::to_string(power_series::truncate(e, 4));
+  EXPECT(s == "2 + 6x + 13x^2 + 24x^3");
+  return true;
+}
+
+DEF_TEST(TruncateSeriesInfinite, PowerSeries)
+{
+  auto e = power_series::multiply(view::iota(1), view::iota(1));
+  string s = power_series::to_string(power_series::truncate(e, 3));
+  EXPECT(s == "1 + 4x + 10x^2");
+  return true;
+}
+
+DEF_TEST(TruncateSeriesReads, PowerSeries)
+{
+  // only as many input coefficients are read as the result needs
+  int highest = 0;
+  auto r = view::transform(view::iota(0), [&] (int i) {
+      highest = std::max(highest, i);
+      return i + 1;
+    });
+  auto e = power_series::subtract(power_series::multiply(r, r),
+                                  power_series::integrate(r));
+  auto t = power_series::truncate(e, 3);
+  EXPECT(ranges::distance(t) == 3);
+  EXPECT(ranges::at(t, 2) == 10 - 1);
+  EXPECT(highest == 2);
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+// Recursive definitions
+
+DEF_TEST(FixExp, PowerSeries)
+{
+  auto e = power_series::fix<float>([] (auto e) {
+      return power_series::add(view::single(1), power_series::integrate(e));
+    });
+  EXPECT(ranges::at(e, 0) == 1.f);
+  EXPECT(ranges::at(e, 1) == 1.f);
+  EXPECT(ranges::at(e, 2) == 1.f/2.f);
+  EXPECT(ranges::at(e, 3) == 1.f/6.f);
+  EXPECT(ranges::at(e, 4) == 1.f/24.f);
+  return true;
+}
+
+DEF_TEST(FixSinCos, PowerSeries)
+{
+  auto sc = power_series::fix<float>(
+      [] (auto, auto cos) {
+        return power_series::integrate(cos);
+      },
+      [] (auto sin, auto) {
+        return power_series::subtract(view::single(1), power_series::integrate(sin));
+      });
+  auto sin = sc[0];
+  auto cos = sc[1];
+  EXPECT(ranges::at(sin, 0) == 0.f);
+  EXPECT(ranges::at(sin, 1) == 1.f);
+  EXPECT(ranges::at(sin, 2) == 0.f);
+  EXPECT(ranges::at(sin, 3) == -1.f/6.f);
+  EXPECT(ranges::at(cos, 0) == 1.f);
+  EXPECT(ranges::at(cos, 2) == -1.f/2.f);
+  EXPECT(ranges::at(cos, 4) == 1.f/24.f);
+  return true;
+}
+
+DEF_TEST(FixCatalan, PowerSeries)
+{
+  // c = 1 + x.c^2 generates the Catalan numbers
+  auto c = power_series::fix<int>([] (auto c) {
+      return power_series::add(
+          view::single(1),
+          view::concat(view::single(0),
+                       power_series::multiply(c, c, series_mult_strategy::relaxed{})));
+    });
+  string s = power_series::to_string(view::take(c, 6));
+  EXPECT(s == "1 + x + 2x^2 + 5x^3 + 14x^4 + 42x^5");
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+// Evaluation
+
+DEF_TEST(EvaluateSeries, PowerSeries)
+{
+  vector<int> v1{1, 2, -3};
+  EXPECT(power_series::evaluate(v1, 2) == -7);
+  EXPECT(power_series::evaluate(v1, 0.5) == 1.25);
+  EXPECT(power_series::evaluate(vector<int>{}, 3) == 0);
+  // long enough for Estrin's scheme
+  vector<long> v2(100, 1);
+  EXPECT(power_series::evaluate(v2, 1L) == 100);
+  EXPECT(power_series::evaluate(power_series::truncate(view::repeat(1), 40), -1) == 0);
+  return true;
+}
+
+DEF_TEST(EvaluateMany, PowerSeries)
+{
+  vector<double> v1{1, -2, 0.5, 3};
+  vector<double> xs;
+  for (int i = 0; i < 37; ++i)
+    xs.push_back(i * 0.25 - 4);
+  vector<double> ys(xs.size());
+  auto e = power_series::evaluate_many(v1, xs, ys.begin());
+  EXPECT(e == ys.end());
+  for (size_t j = 0; j < xs.size(); ++j)
+  {
+    double x = xs[j];
+    EXPECT(ys[j] == ((3 * x + 0.5) * x - 2) * x + 1);
+  }
+  return true;
+}
+
+DEF_TEST(EvaluateManyTree, PowerSeries)
+{
+  // enough terms and points for the subproduct tree
+  using mod = power_series::modular<998244353>;
+  size_t n = 5000;
+  vector<mod> f(n);
+  vector<mod> xs(n);
+  for (size_t i = 0; i < n; ++i)
+  {
+    f[i] = static_cast<int64_t>(i * i % 101);
+    xs[i] = static_cast<int64_t>(i * 7919 + 3);
+  }
+  vector<mod> ys;
+  power_series::evaluate_many(f, xs, back_inserter(ys));
+  EXPECT(ys.size() == n);
+  for (size_t j = 0; j < n; j += 97)
+  {
+    mod y{};
+    for (size_t i = n; i-- > 0;)
+      y = y * xs[j] + f[i];
+    EXPECT(ys[j] == y);
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+// Summation
+
+DEF_TEST(SumAtExp, PowerSeries)
+{
+  auto e = view::transform(view::iota(0), [] (int k) { return 1 / tgamma(k + 1.0); });
+  auto s = power_series::sum_at(e, 1.0, 1e-12);
+  EXPECT(s.converged);
+  EXPECT(s.terms < 20);
+  EXPECT(abs(s.value - exp(1.0)) < 1e-12);
+  return true;
+}
+
+DEF_TEST(SumAtFinite, PowerSeries)
+{
+  vector<int> v1{1, 2, 3};
+  auto s = power_series::sum_at(v1, 2.0, 1e-12);
+  EXPECT(s.converged);
+  EXPECT(s.terms == 3);
+  EXPECT(s.value == 17);
+  return true;
+}
+
+DEF_TEST(SumAtZeros, PowerSeries)
+{
+  // at 0 only the constant term counts
+  auto s = power_series::sum_at(view::iota(1), 0.0, 1e-12);
+  EXPECT(s.converged);
+  EXPECT(s.terms == 1);
+  EXPECT(s.value == 1);
+  // an infinite series that is zero from x^3 on
+  vector<double> v1{1, 2, 3};
+  auto padded = view::concat(v1, view::repeat(0.0));
+  auto p = power_series::sum_at(padded, 0.5, 1e-12);
+  EXPECT(p.converged);
+  EXPECT(p.terms < 30);
+  EXPECT(p.value == 2.75);
+  // gaps of zeros between terms don't end the sum early: sinh(1)
+  auto odd = view::transform(view::iota(0), [] (int k) {
+      return k % 2 ? 1 / tgamma(k + 1.0) : 0.0; });
+  auto h = power_series::sum_at(odd, 1.0, 1e-12);
+  EXPECT(h.converged);
+  EXPECT(abs(h.value - std::sinh(1.0)) < 1e-12);
+  return true;
+}
+
+DEF_TEST(SumAtAccelerated, PowerSeries)
+{
+  // log 2 = 1 - 1/2 + 1/3 - ...
+  auto log1p = view::transform(view::iota(0), [] (int k) {
+      return k == 0 ? 0.0 : (k % 2 ? 1.0 : -1.0) / k; });
+  auto direct = power_series::sum_at(log1p, 1.0, 1e-9,
+                                     power_series::summation::direct{}, 1000);
+  EXPECT(!direct.converged);
+  EXPECT(direct.terms == 1000);
+  auto euler = power_series::sum_at(log1p, 1.0, 1e-10,
+                                    power_series::summation::euler{});
+  EXPECT(euler.converged);
+  EXPECT(euler.terms < 50);
+  EXPECT(abs(euler.value - log(2.0)) < 1e-9);
+
+  // 1/(1 - x) at 0.9
+  auto aitken = power_series::sum_at(view::repeat(1.0), 0.9, 1e-12,
+                                     power_series::summation::aitken{});
+  EXPECT(aitken.converged);
+  EXPECT(aitken.terms < 10);
+  EXPECT(abs(aitken.value - 10) < 1e-10);
+  return true;
+}
+
 // -----------------------------------------------------------------------------
 // Printing
 
@@ -0,0 +1,135 @@
+#include "rational_series.hpp"
+#include "power_series.hpp"
+#include "modular.hpp"
+
+#include <range/v3/all.hpp>
+
+#include <testinator.h>
+
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace ranges;
+
+// -----------------------------------------------------------------------------
+// Tests for rational_series
+
+DEF_TEST(Fibonacci, RationalSeries)
+{
+  // x / (1 - x - x^2)
+  rational_series<int64_t> f{{0, 1}, {1, -1, -1}};
+  string s = power_series::to_string(view::take(f, 7));
+  EXPECT(s == "x + x^2 + 2x^3 + 3x^4 + 5x^5 + 8x^6");
+  EXPECT(f.coefficient(50) == 12586269025);
+  EXPECT(ranges::at(f, 90) == 2880067194370816120);
+  return true;
+}
+
+DEF_TEST(CoefficientFarOut, RationalSeries)
+{
+  // far past anything that could be streamed
+  using M = power_series::modular<998244353>;
+  rational_series<M> f{{M(0), M(1)}, {M(1), -M(1), -M(1)}};
+  auto far = f.coefficient(1000000000000000000u);
+  // F(2n) = F(n).(2F(n+1) - F(n))
+  auto n = f.coefficient(500000000000000000u);
+  auto n1 = f.coefficient(500000000000000001u);
+  EXPECT(far == n * (M(2) * n1 - n));
+  return true;
+}
+
+DEF_TEST(CoefficientInteger, RationalSeries)
+{
+  // 1 / (1 - x)^2: the denominators Bostan-Mori squares outgrow int long
+  // before n + 1 does
+  rational_series<int> f{{1}, {1, -2, 1}};
+  EXPECT(f.coefficient(1000000) == 1000001);
+  rational_series<short> g{{-1}, {-1, 2, -1}};
+  EXPECT(g.coefficient(30000) == 30001);
+  return true;
+}
+
+DEF_TEST(CursorJumps, RationalSeries)
+{
+  // 1 / (1 - 2x + x^3)
+  rational_series<int64_t> f{{1}, {1, -2, 0, 1}};
+  vector<int64_t> c = view::take(f, 40);
+  auto it = ranges::begin(f) + 30;
+  EXPECT(*it == c[30]);
+  EXPECT(*(it - 25) == c[5]);
+  EXPECT(*(it + 1) == c[31]);
+  EXPECT(ranges::equal(view::take(view::drop(f, 35), 5), view::drop(c, 35)));
+  return true;
+}
+
+DEF_TEST(FromCycle, RationalSeries)
+{
+  vector<int> v{1, 2, 3};
+  rational_series<int> r = view::cycle(v);
+  EXPECT(ranges::equal(view::take(r, 9), view::take(view::cycle(v), 9)));
+  EXPECT(r.coefficient(3001) == 2);
+  return true;
+}
+
+DEF_TEST(ClosedForm, RationalSeries)
+{
+  vector<int> v1{1, 2, 3};
+  vector<int> v2{1, -1};
+  auto c1 = view::cycle(v1);
+  auto c2 = view::cycle(v2);
+
+  auto sum = power_series::add(c1, c2);
+  EXPECT(ranges::equal(view::take(sum, 12),
+                       view::take(view::monoidal_zip(std::plus<>(), c1, c2), 12)));
+  auto difference = power_series::subtract(c1, c1);
+  EXPECT(difference.coefficient(100) == 0);
+
+  auto product = power_series::multiply(c1, c2);
+  vector<int> p1 = view::take(c1, 20);
+  vector<int> p2 = view::take(c2, 20);
+  EXPECT(ranges::equal(view::take(product, 20),
+                       view::take(power_series::multiply(p1, p2), 20)));
+
+  auto derivative = power_series::differentiate(c1);
+  EXPECT(ranges::equal(view::take(derivative, 10),
+                       view::take(power_series::differentiate(p1), 10)));
+  EXPECT(ranges::at(power_series::negate(c1), 4) == -2);
+  return true;
+}
+
+DEF_TEST(FindRecurrence, RationalSeries)
+{
+  using M = power_series::modular<998244353>;
+  // n^2 has generating function x(1 + x)/(1 - x)^3
+  auto squares = view::transform(view::iota(0), [] (int n) { return M(n) * M(n); });
+  auto r = power_series::find_recurrence(squares, 5);
+  EXPECT(r.order() == 3);
+  EXPECT(ranges::equal(view::take(r, 20), view::take(squares, 20)));
+  EXPECT(r.coefficient(1000000) == M(1000000) * M(1000000));
+  return true;
+}
+
+DEF_TEST(FindRecurrenceTooShort, RationalSeries)
+{
+  using M = power_series::modular<998244353>;
+  auto squares = view::transform(view::iota(0), [] (int n) { return M(n) * M(n); });
+  auto r = power_series::find_recurrence(squares, 2);
+  EXPECT(r.order() > 2);
+  EXPECT(ranges::equal(view::take(r, 4), view::take(squares, 4)));
+  return true;
+}
+
+DEF_TEST(FindRecurrenceFloating, RationalSeries)
+{
+  auto f = [] (int n) { return std::pow(0.5, n) + std::pow(-0.25, n); };
+  auto s = view::transform(view::iota(0), f);
+  auto r = power_series::find_recurrence(s, 4, 1e-9);
+  EXPECT(r.order() == 2);
+  EXPECT(std::abs(ranges::at(r, 30) - f(30)) < 1e-12);
+  EXPECT(std::abs(r.coefficient(40) - f(40)) < 1e-12);
+  return true;
+}
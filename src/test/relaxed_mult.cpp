@@ -0,0 +1,80 @@
+#include "relaxed_mult.hpp"
+#include "iterate.hpp"
+
+#include <range/v3/all.hpp>
+
+#include <testinator.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace ranges;
+
+// -----------------------------------------------------------------------------
+// Tests for relaxed_mult
+
+DEF_TEST(Finite, RelaxedMult)
+{
+  vector<int> v1{1, 2, 3, 4, 5};
+  vector<int> v2{1, 2, 3};
+  auto m = view::relaxed_mult(v1, v2);
+  string s = ranges::accumulate(
+      m,
+      string(),
+      [] (string s, int x) {
+        return s + to_string(x) + " ";
+      });
+  EXPECT(s == "1 4 10 16 22 22 15 ");
+  return true;
+}
+
+DEF_TEST(Empty, RelaxedMult)
+{
+  vector<int> v1;
+  vector<int> v2{1, 2, 3};
+  EXPECT(ranges::distance(view::relaxed_mult(v1, v2)) == 0);
+  EXPECT(ranges::distance(view::relaxed_mult(v2, v1)) == 0);
+  EXPECT(ranges::distance(view::relaxed_mult(v1, v1)) == 0);
+  return true;
+}
+
+DEF_TEST(MatchesNaive, RelaxedMult)
+{
+  // long enough for the squares to go through the Karatsuba kernel
+  auto m = view::relaxed_mult(view::iota(1), view::iota(1));
+  auto n = view::series_mult(view::iota(1), view::iota(1));
+  EXPECT(ranges::equal(view::take(m, 300), view::take(n, 300)));
+  return true;
+}
+
+DEF_TEST(SinglePass, RelaxedMult)
+{
+  // iterate is single-pass; each input element is read exactly once
+  auto m = view::relaxed_mult(view::iterate([] (int x) { return x + 1; }, 1),
+                              view::iterate([] (int x) { return x + 1; }, 1));
+  EXPECT(ranges::at(m, 2) == 10);
+  EXPECT(ranges::at(m, 0) == 1);
+  EXPECT(ranges::at(m, 1) == 4);
+  return true;
+}
+
+DEF_TEST(Threads, RelaxedMult)
+{
+  // copies of one product read on several threads share its coefficients
+  auto m = view::relaxed_mult(view::iota(1), view::iota(1));
+  vector<int> expected = view::take(view::series_mult(view::iota(1), view::iota(1)), 2000);
+  vector<thread> threads;
+  atomic<bool> ok{true};
+  for (int t = 0; t < 4; ++t)
+    threads.emplace_back([m, &expected, &ok] {
+        if (!ranges::equal(view::take(m, 2000), expected))
+          ok = false;
+      });
+  for (auto& t : threads)
+    t.join();
+  EXPECT(ok.load());
+  return true;
+}
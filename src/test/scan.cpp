@@ -26,3 +26,41 @@ DEF_TEST(BasicScan, Scan)
   EXPECT(s == "0136");
   return true;
 }
+
+DEF_TEST(ScanMultiPass, Scan)
+{
+  vector<int> v1 = {1, 2, 3};
+  auto const m = view::scan(v1, 0);
+  EXPECT(ranges::equal(m, vector<int>{0, 1, 3, 6}));
+  EXPECT(ranges::equal(m, vector<int>{0, 1, 3, 6}));
+  auto it = ranges::begin(m);
+  auto jt = ranges::next(it, 2);
+  EXPECT(*it == 0 && *jt == 3);
+  return true;
+}
+
+DEF_TEST(CheckpointedScan, Scan)
+{
+  vector<int> v1 = {1, 2, 3, 4, 5, 6, 7};
+  auto m = view::checkpointed_scan(v1, 0, 3);
+  EXPECT(ranges::equal(m, view::scan(v1, 0)));
+  EXPECT(ranges::at(m, 7) == 28);
+  EXPECT(ranges::at(m, 2) == 3);
+  auto it = ranges::begin(m) + 6;
+  EXPECT(*it == 21);
+  EXPECT(*(it - 5) == 1);
+  EXPECT(ranges::distance(m) == 8);
+  return true;
+}
+
+DEF_TEST(CheckpointedScanInfinite, Scan)
+{
+  // copies share the checkpoints, so the second jump starts from near the
+  // element rather than from the beginning
+  auto m = view::checkpointed_scan(view::iota(1), 0L, 64);
+  auto copy = m;
+  EXPECT(ranges::at(m, 100000) == 100000L * 100001L / 2);
+  EXPECT(ranges::at(copy, 99999) == 99999L * 100000L / 2);
+  EXPECT(ranges::at(copy, 10) == 55);
+  return true;
+}
@@ -0,0 +1,58 @@
+#include "scan.hpp"
+#include "scan_parallel.hpp"
+
+#include <range/v3/all.hpp>
+
+#include <testinator.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace ranges;
+
+// -----------------------------------------------------------------------------
+// Tests for scan_parallel
+
+DEF_TEST(MatchesScan, ScanParallel)
+{
+  thread_pool pool{4};
+  for (int k : {0, 1, 3, 4, 5, 100, 1001})
+  {
+    auto n = static_cast<size_t>(k);
+    vector<int32_t> v(n);
+    for (size_t i = 0; i < n; ++i)
+      v[i] = static_cast<int32_t>(i * 7 % 13) - 6;
+    vector<int32_t> out(n + 1);
+    auto last = scan_parallel(v, 3, plus{}, ident{}, out.begin(), pool);
+    EXPECT(last == out.end());
+    EXPECT(ranges::equal(out, view::scan(v, 3)));
+  }
+  return true;
+}
+
+DEF_TEST(Projection, ScanParallel)
+{
+  thread_pool pool{3};
+  vector<int> v{1, 2, 3, 4, 5, 6, 7};
+  vector<long> out(v.size() + 1);
+  auto square = [] (int x) { return static_cast<long>(x) * x; };
+  scan_parallel(v, 0L, plus{}, square, out.begin(), pool);
+  EXPECT(ranges::equal(out, view::scan(v, 0L, plus{}, square)));
+  return true;
+}
+
+DEF_TEST(NonCommutative, ScanParallel)
+{
+  // only associativity is needed: blocks are combined in order
+  thread_pool pool{4};
+  vector<string> v;
+  for (int i = 0; i < 50; ++i)
+    v.push_back(to_string(i % 10));
+  vector<string> out(v.size() + 1);
+  scan_parallel(v, string(">"), plus{}, ident{}, out.begin(), pool);
+  EXPECT(ranges::equal(out, view::scan(v, string(">"))));
+  return true;
+}
@@ -0,0 +1,115 @@
+#include "series_fill.hpp"
+#include "any_series.hpp"
+#include "cycle.hpp"
+#include "iterate.hpp"
+#include "monoidal_zip.hpp"
+#include "power_series.hpp"
+#include "rational_series.hpp"
+#include "scan.hpp"
+#include "series_mult.hpp"
+
+#include <range/v3/all.hpp>
+
+#include <testinator.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace ranges;
+
+namespace
+{
+  // the bulk fill agrees with reading the range a coefficient at a time
+  template <typename T, typename Rng>
+  bool fills_as_read(Rng&& r, size_t n)
+  {
+    vector<T> bulk(n);
+    bulk.resize(ranges::series_fill(r, bulk.data(), n));
+    vector<T> read;
+    for (auto&& x : r)
+    {
+      if (read.size() == n)
+        break;
+      read.push_back(x);
+    }
+    return bulk == read;
+  }
+}
+
+// -----------------------------------------------------------------------------
+// Tests for series_fill
+
+DEF_TEST(Cycle, SeriesFill)
+{
+  vector<int> v{1, 2, 3};
+  for (size_t n = 0; n < 20; ++n)
+    EXPECT(fills_as_read<int>(view::cycle(v), n));
+  return true;
+}
+
+DEF_TEST(Iterate, SeriesFill)
+{
+  auto r = view::iterate([] (int x) { return 2 * x + 1; }, 0);
+  EXPECT(fills_as_read<int>(r, 10));
+  return true;
+}
+
+DEF_TEST(Scan, SeriesFill)
+{
+  vector<int> v{1, 2, 3, 4};
+  EXPECT(fills_as_read<int>(view::scan(v, 0), 3));
+  EXPECT(fills_as_read<int>(view::scan(v, 0), 10));
+  EXPECT(fills_as_read<int>(view::scan(v, 1, std::multiplies<int>()), 10));
+  return true;
+}
+
+DEF_TEST(MonoidalZip, SeriesFill)
+{
+  vector<int> v1{1, 2, 3, 4, 5};
+  vector<int> v2{10, 20};
+  EXPECT(fills_as_read<int>(view::monoidal_zip(std::plus<>(), v1, v2), 10));
+  EXPECT(fills_as_read<int>(view::monoidal_zip(std::plus<>(), v2, v1), 10));
+  EXPECT(fills_as_read<int>(view::monoidal_zip(std::plus<>(), v2, view::cycle(v1)), 12));
+  return true;
+}
+
+DEF_TEST(Multiply, SeriesFill)
+{
+  vector<int> v1{1, 2, 3, 4, 5};
+  vector<int> v2{1, -1, 2};
+  // eager
+  EXPECT(fills_as_read<int>(view::series_mult(v1, v2), 10));
+  EXPECT(fills_as_read<int>(view::series_mult(v1, v2), 4));
+  // lazy, over infinite inputs
+  EXPECT(fills_as_read<int>(view::series_mult(view::cycle(v1), view::iota(1)), 30));
+  return true;
+}
+
+DEF_TEST(PowerSeriesViews, SeriesFill)
+{
+  vector<int> v1{1, 2, 3, 4, 5};
+  vector<int> v2{7, 6, 5};
+  EXPECT(fills_as_read<int>(power_series::add(v1, v2), 10));
+  EXPECT(fills_as_read<int>(power_series::negate(view::iota(0)), 10));
+  EXPECT(fills_as_read<int>(power_series::differentiate(v1), 10));
+  EXPECT(fills_as_read<float>(power_series::integrate(v1), 10));
+  EXPECT(fills_as_read<int64_t>(rational_series<int64_t>{{0, 1}, {1, -1, -1}}, 40));
+  any_series<int> s = view::cycle(v1);
+  EXPECT(fills_as_read<int>(s, 200));
+  return true;
+}
+
+DEF_TEST(ToVector, SeriesFill)
+{
+  vector<int> v1{1, 2, 3};
+  auto c = view::cycle(v1);
+  EXPECT(power_series::to_vector(c, 7) == (vector<int>{1, 2, 3, 1, 2, 3, 1}));
+  EXPECT(power_series::to_vector(power_series::add(v1, v1)) == (vector<int>{2, 4, 6}));
+  EXPECT(power_series::to_string(power_series::multiply(v1, v1)) ==
+         "1 + 4x + 10x^2 + 12x^3 + 9x^4");
+  return true;
+}
@@ -0,0 +1,153 @@
+#include "simd.hpp"
+
+#include <testinator.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+// -----------------------------------------------------------------------------
+// Tests for simd
+
+namespace
+{
+  template <typename T>
+  T reversed_dot_reference(const vector<T>& a, const vector<T>& b)
+  {
+    T s{};
+    for (size_t i = 0; i < a.size(); ++i)
+      s += a[i] * b[a.size() - 1 - i];
+    return s;
+  }
+
+  // every length up to a few vectors' worth, so that each kernel's main
+  // loop and scalar remainder are both exercised; the values are small
+  // integers, so any summation order is exact
+  template <typename T>
+  bool check_reversed_dot()
+  {
+    for (size_t n = 0; n < 70; ++n)
+    {
+      vector<T> a(n);
+      vector<T> b(n);
+      for (size_t i = 0; i < n; ++i)
+      {
+        a[i] = static_cast<T>(static_cast<int>(i * 7 % 13) - 6);
+        b[i] = static_cast<T>(static_cast<int>(i * i % 11) - 5);
+      }
+      if (ranges::detail::reversed_dot(a.data(), b.data(), n)
+          != reversed_dot_reference(a, b))
+        return false;
+    }
+    return true;
+  }
+}
+
+DEF_TEST(ReversedDotInt, Simd)
+{
+  EXPECT(check_reversed_dot<int32_t>());
+  return true;
+}
+
+DEF_TEST(ReversedDotDouble, Simd)
+{
+  EXPECT(check_reversed_dot<double>());
+  return true;
+}
+
+DEF_TEST(ReversedDotFloat, Simd)
+{
+  EXPECT(check_reversed_dot<float>());
+  return true;
+}
+
+DEF_TEST(ReversedDotGeneric, Simd)
+{
+  EXPECT(check_reversed_dot<long>());
+  EXPECT(check_reversed_dot<long long>());
+  return true;
+}
+
+DEF_TEST(InclusiveScanInt, Simd)
+{
+  for (size_t n = 0; n < 40; ++n)
+  {
+    vector<int32_t> a(n);
+    vector<int32_t> out(n);
+    vector<int32_t> expected(n);
+    int32_t s = 5;
+    for (size_t i = 0; i < n; ++i)
+    {
+      a[i] = static_cast<int32_t>(i * 7 % 13) - 6;
+      expected[i] = s += a[i];
+    }
+    ranges::detail::inclusive_scan(a.data(), n, 5, out.data());
+    EXPECT(out == expected);
+    // in place
+    ranges::detail::inclusive_scan(a.data(), n, 5, a.data());
+    EXPECT(a == expected);
+  }
+  return true;
+}
+
+namespace
+{
+  template <typename T>
+  T horner_reference(const vector<T>& c, T x)
+  {
+    T y{};
+    for (size_t i = c.size(); i-- > 0;)
+      y = y * x + c[i];
+    return y;
+  }
+
+  // small integers and halves, so that every result is exact
+  template <typename T>
+  bool check_horner_many()
+  {
+    for (size_t n = 0; n < 12; ++n)
+      for (size_t m = 0; m < 40; ++m)
+      {
+        vector<T> c(n);
+        vector<T> xs(m);
+        vector<T> ys(m);
+        for (size_t i = 0; i < n; ++i)
+          c[i] = static_cast<T>(static_cast<int>(i * 7 % 13) - 6);
+        for (size_t j = 0; j < m; ++j)
+          xs[j] = static_cast<T>(static_cast<int>(j % 5) - 2) / static_cast<T>(2);
+        ranges::detail::horner_many(c.data(), n, xs.data(), m, ys.data());
+        for (size_t j = 0; j < m; ++j)
+          if (ys[j] != horner_reference(c, xs[j]))
+            return false;
+      }
+    return true;
+  }
+}
+
+DEF_TEST(HornerMany, Simd)
+{
+  EXPECT(check_horner_many<double>());
+  EXPECT(check_horner_many<float>());
+  EXPECT(check_horner_many<int32_t>());
+  return true;
+}
+
+DEF_TEST(Estrin, Simd)
+{
+  for (size_t n = 0; n < 70; ++n)
+  {
+    vector<int64_t> c(n);
+    for (size_t i = 0; i < n; ++i)
+      c[i] = static_cast<int64_t>(i * 7 % 13) - 6;
+    EXPECT(ranges::detail::estrin(c.data(), n, int64_t{1}) == horner_reference(c, int64_t{1}));
+    EXPECT(ranges::detail::estrin(c.data(), n, int64_t{-1}) == horner_reference(c, int64_t{-1}));
+    // distinct powers catch a term joined with the wrong power of x; 3^35
+    // times the coefficients still fits in 64 bits
+    if (n < 36)
+      for (int64_t x : {2, 3, -3})
+        EXPECT(ranges::detail::estrin(c.data(), n, x) == horner_reference(c, x));
+  }
+  return true;
+}
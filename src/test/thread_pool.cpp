@@ -0,0 +1,71 @@
+#include "thread_pool.hpp"
+
+#include <testinator.h>
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+using namespace ranges;
+
+// -----------------------------------------------------------------------------
+// Tests for thread_pool
+
+DEF_TEST(RunsEveryTask, ThreadPool)
+{
+  thread_pool pool{4};
+  EXPECT(pool.size() == 4u);
+  vector<atomic<int>> runs(1000);
+  pool.run(runs.size(), [&] (size_t i) { ++runs[i]; });
+  for (auto& r : runs)
+    EXPECT(r == 1);
+  return true;
+}
+
+DEF_TEST(RunsManyJobs, ThreadPool)
+{
+  thread_pool pool{3};
+  atomic<size_t> total{0};
+  for (size_t job = 0; job < 100; ++job)
+    pool.run(job, [&] (size_t i) { total += i; });
+  // sum over jobs j of 0 + 1 + ... + (j-1)
+  EXPECT(total == 161700u);
+  return true;
+}
+
+DEF_TEST(SingleThread, ThreadPool)
+{
+  thread_pool pool{1};
+  size_t total = 0;
+  pool.run(10, [&] (size_t i) { total += i; });
+  EXPECT(total == 45u);
+  return true;
+}
+
+DEF_TEST(Rethrows, ThreadPool)
+{
+  thread_pool pool{4};
+  atomic<int> runs{0};
+  bool thrown = false;
+  try
+  {
+    pool.run(100, [&] (size_t i) {
+        ++runs;
+        if (i == 42)
+          throw runtime_error("task failed");
+      });
+  }
+  catch (runtime_error&)
+  {
+    thrown = true;
+  }
+  EXPECT(thrown);
+  EXPECT(runs == 100);
+  // and the pool is still usable
+  runs = 0;
+  pool.run(10, [&] (size_t) { ++runs; });
+  EXPECT(runs == 10);
+  return true;
+}